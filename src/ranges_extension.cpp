@@ -1,729 +1,1602 @@
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
+#include <cstring>
+#include <limits>
 #include <string>
+#include <type_traits>
 #define DUCKDB_EXTENSION_MAIN
 
 #include "ranges_extension.hpp"
 #include "duckdb.hpp"
+#include "duckdb/catalog/default/default_table_functions.hpp"
 #include "duckdb/common/exception.hpp"
+#include "duckdb/common/operator/cast_operators.hpp"
+#include "duckdb/common/types/date.hpp"
+#include "duckdb/common/types/time.hpp"
+#include "duckdb/common/types/timestamp.hpp"
+#include "duckdb/execution/expression_executor.hpp"
+#include "duckdb/function/aggregate_function.hpp"
 #include "duckdb/function/scalar_function.hpp"
+#include "duckdb/function/table_function.hpp"
 #include "duckdb/common/vector_operations/ternary_executor.hpp"
+#include "duckdb/common/vector_operations/vector_operations.hpp"
 #include <duckdb/parser/parsed_data/create_scalar_function_info.hpp>
+#include "duckdb/function/function_binder.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/optimizer/optimizer_extension.hpp"
+#include "duckdb/planner/expression/bound_comparison_expression.hpp"
+#include "duckdb/planner/expression/bound_conjunction_expression.hpp"
+#include "duckdb/planner/expression/bound_constant_expression.hpp"
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+#include "duckdb/planner/operator/logical_any_join.hpp"
+#include "duckdb/planner/operator/logical_filter.hpp"
+#include "duckdb/storage/object_cache.hpp"
+#include "duckdb/storage/statistics/numeric_stats.hpp"
+#include "duckdb/storage/statistics/struct_stats.hpp"
+#include "fmt/format.h"
 
 namespace duckdb {
 
-struct Int4Range {
-	int32_t lower;
-	int32_t upper;
+//! A decoded range over bounds of type T. An infinite (unbounded) side holds the lowest or highest value of T as
+//! an inclusive bound, so the kernels compare it like any other bound; its flag only matters for the encoding.
+template <class T>
+struct Range {
+	T lower;
+	T upper;
 	bool lower_inc;
 	bool upper_inc;
+	bool lower_inf;
+	bool upper_inf;
 };
 
-struct NumRange {
-	double lower;
-	double upper;
-	bool lower_inc;
-	bool upper_inc;
+using Int4Range = Range<int32_t>;
+using Int8Range = Range<int64_t>;
+using NumRange = Range<double>;
+using DateRange = Range<date_t>;
+using TsRange = Range<timestamp_t>;
+using TstzRange = Range<timestamp_tz_t>;
+
+//===--------------------------------------------------------------------===//
+// Range Subtypes
+//===--------------------------------------------------------------------===//
+// RangeTraits<T> describes the range type over bound type T: its SQL names, the bound type and its lowest and
+// highest values, which infinite bounds are stored as. Discrete subtypes, whose values have a successor,
+// additionally provide Successor() and are stored in a canonical form (see CanonicalizeRange). Every range
+// function is a template instantiated per subtype.
+
+template <class T>
+struct RangeTraits;
+
+template <>
+struct RangeTraits<int32_t> {
+	static constexpr bool DISCRETE = true;
+	static const char *TypeName() {
+		return "INT4RANGE";
+	}
+	static const char *MultirangeTypeName() {
+		return "INT4MULTIRANGE";
+	}
+	static const char *BoundName() {
+		return "integer";
+	}
+	static LogicalType BoundType() {
+		return LogicalType::INTEGER;
+	}
+	static int32_t Lowest() {
+		return NumericLimits<int32_t>::Minimum();
+	}
+	static int32_t Highest() {
+		return NumericLimits<int32_t>::Maximum();
+	}
+	static int32_t Successor(int32_t value) {
+		return value + 1;
+	}
 };
 
-LogicalType GetInt4RangeType() {
-	auto type = LogicalType(LogicalTypeId::BLOB);
-	type.SetAlias("INT4RANGE");
+template <>
+struct RangeTraits<int64_t> {
+	static constexpr bool DISCRETE = true;
+	static const char *TypeName() {
+		return "INT8RANGE";
+	}
+	static const char *MultirangeTypeName() {
+		return "INT8MULTIRANGE";
+	}
+	static const char *BoundName() {
+		return "bigint";
+	}
+	static LogicalType BoundType() {
+		return LogicalType::BIGINT;
+	}
+	static int64_t Lowest() {
+		return NumericLimits<int64_t>::Minimum();
+	}
+	static int64_t Highest() {
+		return NumericLimits<int64_t>::Maximum();
+	}
+	static int64_t Successor(int64_t value) {
+		return value + 1;
+	}
+};
+
+template <>
+struct RangeTraits<double> {
+	static constexpr bool DISCRETE = false;
+	static const char *TypeName() {
+		return "NUMRANGE";
+	}
+	static const char *MultirangeTypeName() {
+		return "NUMMULTIRANGE";
+	}
+	static const char *BoundName() {
+		return "number";
+	}
+	static LogicalType BoundType() {
+		return LogicalType::DOUBLE;
+	}
+	static double Lowest() {
+		return -std::numeric_limits<double>::infinity();
+	}
+	static double Highest() {
+		return std::numeric_limits<double>::infinity();
+	}
+};
+
+template <>
+struct RangeTraits<date_t> {
+	static constexpr bool DISCRETE = true;
+	static const char *TypeName() {
+		return "DATERANGE";
+	}
+	static const char *MultirangeTypeName() {
+		return "DATEMULTIRANGE";
+	}
+	static const char *BoundName() {
+		return "date";
+	}
+	static LogicalType BoundType() {
+		return LogicalType::DATE;
+	}
+	static date_t Lowest() {
+		return date_t(NumericLimits<int32_t>::Minimum());
+	}
+	static date_t Highest() {
+		return date_t(NumericLimits<int32_t>::Maximum());
+	}
+	static date_t Successor(date_t value) {
+		return date_t(value.days + 1);
+	}
+};
+
+template <>
+struct RangeTraits<timestamp_t> {
+	static constexpr bool DISCRETE = false;
+	static const char *TypeName() {
+		return "TSRANGE";
+	}
+	static const char *MultirangeTypeName() {
+		return "TSMULTIRANGE";
+	}
+	static const char *BoundName() {
+		return "timestamp";
+	}
+	static LogicalType BoundType() {
+		return LogicalType::TIMESTAMP;
+	}
+	static timestamp_t Lowest() {
+		return timestamp_t(NumericLimits<int64_t>::Minimum());
+	}
+	static timestamp_t Highest() {
+		return timestamp_t(NumericLimits<int64_t>::Maximum());
+	}
+};
+
+template <>
+struct RangeTraits<timestamp_tz_t> {
+	static constexpr bool DISCRETE = false;
+	static const char *TypeName() {
+		return "TSTZRANGE";
+	}
+	static const char *MultirangeTypeName() {
+		return "TSTZMULTIRANGE";
+	}
+	static const char *BoundName() {
+		return "timestamp with time zone";
+	}
+	static LogicalType BoundType() {
+		return LogicalType::TIMESTAMP_TZ;
+	}
+	static timestamp_tz_t Lowest() {
+		return timestamp_tz_t(NumericLimits<int64_t>::Minimum());
+	}
+	static timestamp_tz_t Highest() {
+		return timestamp_tz_t(NumericLimits<int64_t>::Maximum());
+	}
+};
+
+//===--------------------------------------------------------------------===//
+// Physical Layout
+//===--------------------------------------------------------------------===//
+// Every range type is a STRUCT(lower T, lower_kind UTINYINT, upper T, upper_kind UTINYINT) with a type alias.
+// Keeping the bounds in plain fixed-width children lets storage compress and zonemap them like any other
+// numeric column, and building a range never touches the string heap.
+//
+// DuckDB orders structs by comparing their children left to right, so the children and kind codes are laid out
+// such that this native order is the PostgreSQL range order: the empty range first, then by lower bound with an
+// inclusive lower bound before an exclusive one, then by upper bound with an exclusive upper bound before an
+// inclusive one. ORDER BY, MIN/MAX and window frames on ranges therefore run on DuckDB's own sort.
+//
+// An infinite bound is stored as the lowest or highest value with its own kind, which sorts before (lower) or
+// after (upper) every finite bound at that value. An infinite lower bound shares kind 0 with the empty range;
+// the empty range is the one whose upper kind is 0 as well, so it still sorts first.
+
+// lower_kind codes
+static constexpr uint8_t RANGE_LOWER_INFINITE = 0;
+static constexpr uint8_t RANGE_LOWER_INCLUSIVE = 1;
+static constexpr uint8_t RANGE_LOWER_EXCLUSIVE = 2;
+// upper_kind codes
+static constexpr uint8_t RANGE_UPPER_EXCLUSIVE = 1;
+static constexpr uint8_t RANGE_UPPER_INCLUSIVE = 2;
+static constexpr uint8_t RANGE_UPPER_INFINITE = 3;
+// Both kinds of the empty range, so that it sorts before every other range
+static constexpr uint8_t RANGE_EMPTY_KIND = 0;
+
+// Child indexes of the range STRUCT
+static constexpr idx_t RANGE_LOWER_INDEX = 0;
+static constexpr idx_t RANGE_LOWER_KIND_INDEX = 1;
+static constexpr idx_t RANGE_UPPER_INDEX = 2;
+static constexpr idx_t RANGE_UPPER_KIND_INDEX = 3;
+
+//! The plain STRUCT a range is stored as, which is also what Parquet and Arrow readers return for a range column
+static LogicalType MakeRangeStorageType(const LogicalType &bound_type) {
+	child_list_t<LogicalType> children;
+	children.emplace_back("lower", bound_type);
+	children.emplace_back("lower_kind", LogicalType::UTINYINT);
+	children.emplace_back("upper", bound_type);
+	children.emplace_back("upper_kind", LogicalType::UTINYINT);
+	return LogicalType::STRUCT(std::move(children));
+}
+
+static LogicalType MakeRangeType(const LogicalType &bound_type, const string &alias) {
+	auto type = MakeRangeStorageType(bound_type);
+	type.SetAlias(alias);
 	return type;
 }
 
-static string_t SerializeInt4Range(const Int4Range &range, Vector &result) {
-	const size_t size = sizeof(int32_t) * 2 + sizeof(uint8_t);
-	auto data = StringVector::EmptyString(result, size);
-	auto ptr = data.GetDataWriteable();
-	memcpy(ptr, &range.lower, sizeof(int32_t));
-	memcpy(ptr + sizeof(int32_t), &range.upper, sizeof(int32_t));
-	// Pack the two booleans into a single byte: bit 1 = lower_inc, bit 0 = upper_inc
-	uint8_t bounds = (range.lower_inc ? 0b10 : 0) | (range.upper_inc ? 0b01 : 0);
-	memcpy(ptr + sizeof(int32_t) * 2, &bounds, sizeof(uint8_t));
-	return data;
+template <class T>
+static LogicalType GetRangeType() {
+	return MakeRangeType(RangeTraits<T>::BoundType(), RangeTraits<T>::TypeName());
 }
 
-static Int4Range DeserializeInt4Range(const string_t &blob) {
-	const size_t expected_size = sizeof(int32_t) * 2 + sizeof(uint8_t);
-	if (blob.GetSize() < expected_size) {
-		throw InvalidInputException("Invalid INT4RANGE blob: expected %zu bytes, got %zu", expected_size,
-		                            blob.GetSize());
-	}
-	Int4Range range;
-	auto ptr = blob.GetDataUnsafe();
-	memcpy(&range.lower, ptr, sizeof(int32_t));
-	memcpy(&range.upper, ptr + sizeof(int32_t), sizeof(int32_t));
-	// Unpack the byte into two booleans
-	uint8_t bounds;
-	memcpy(&bounds, ptr + sizeof(int32_t) * 2, sizeof(uint8_t));
-	range.lower_inc = (bounds & 0b10) != 0;
-	range.upper_inc = (bounds & 0b01) != 0;
-	return range;
+LogicalType GetInt4RangeType() {
+	return GetRangeType<int32_t>();
 }
 
-static bool IsEmpty(const Int4Range &range) {
-	// If lower > upper, it's empty.
-	// If lower == upper, it's empty unless both bounds are inclusive [].
-	if (range.lower > range.upper) {
-		return true;
-	}
-	if (range.lower == range.upper) {
-		return !(range.lower_inc && range.upper_inc); // Only [] is non-empty for equal bounds
-	}
-	return false;
+LogicalType GetNumRangeType() {
+	return GetRangeType<double>();
 }
 
-static string_t ConstructInt4RangeValue(Vector &result, int32_t lower, int32_t upper, bool lower_inc, bool upper_inc) {
-	Int4Range range = {lower, upper, lower_inc, upper_inc};
-	return SerializeInt4Range(range, result);
+static inline uint8_t LowerKind(bool lower_inc, bool lower_inf) {
+	return lower_inf ? RANGE_LOWER_INFINITE : lower_inc ? RANGE_LOWER_INCLUSIVE : RANGE_LOWER_EXCLUSIVE;
 }
-static Int4Range ParseInt4Range(const string &input_str) {
-	const string &s = input_str;
 
-	if (StringUtil::CIEquals(s, "empty")) {
-		return {1, 0, false, false}; // Canonical empty
-	}
+static inline uint8_t UpperKind(bool upper_inc, bool upper_inf) {
+	return upper_inf ? RANGE_UPPER_INFINITE : upper_inc ? RANGE_UPPER_INCLUSIVE : RANGE_UPPER_EXCLUSIVE;
+}
+
+//! Decodes the kind codes of a range into its inclusivity and infinity flags
+template <class RANGE>
+static inline void DecodeKinds(RANGE &range, uint8_t lower_kind, uint8_t upper_kind) {
+	range.lower_inf = (lower_kind == RANGE_LOWER_INFINITE) & (upper_kind != RANGE_EMPTY_KIND);
+	range.upper_inf = upper_kind == RANGE_UPPER_INFINITE;
+	range.lower_inc = (lower_kind == RANGE_LOWER_INCLUSIVE) | range.lower_inf;
+	range.upper_inc = (upper_kind == RANGE_UPPER_INCLUSIVE) | range.upper_inf;
+}
 
-	if (s.length() < 3) {
-		throw InvalidInputException("Malformed range literal: \"%s\"", input_str);
+//! Reads ranges out of a range STRUCT vector of any vector type
+template <class RANGE>
+struct RangeReader {
+	using BOUND_TYPE = decltype(RANGE::lower);
+
+	RangeReader(Vector &input, idx_t count) {
+		input.ToUnifiedFormat(count, format);
+		// Struct children are always aligned with the rows of the struct itself
+		auto &entries = StructVector::GetEntries(input);
+		entries[RANGE_LOWER_INDEX]->ToUnifiedFormat(count, lower_format);
+		entries[RANGE_LOWER_KIND_INDEX]->ToUnifiedFormat(count, lower_kind_format);
+		entries[RANGE_UPPER_INDEX]->ToUnifiedFormat(count, upper_format);
+		entries[RANGE_UPPER_KIND_INDEX]->ToUnifiedFormat(count, upper_kind_format);
+		lower_data = UnifiedVectorFormat::GetData<BOUND_TYPE>(lower_format);
+		lower_kind_data = UnifiedVectorFormat::GetData<uint8_t>(lower_kind_format);
+		upper_data = UnifiedVectorFormat::GetData<BOUND_TYPE>(upper_format);
+		upper_kind_data = UnifiedVectorFormat::GetData<uint8_t>(upper_kind_format);
 	}
 
-	bool lower_inc;
-	if (s.front() == '[') {
-		lower_inc = true;
-	} else if (s.front() == '(') {
-		lower_inc = false;
-	} else {
-		throw InvalidInputException("Malformed range literal: \"%s\"", input_str);
+	bool RowIsValid(idx_t row) const {
+		return format.validity.RowIsValid(format.sel->get_index(row));
 	}
 
-	bool upper_inc;
-	if (s.back() == ']') {
-		upper_inc = true;
-	} else if (s.back() == ')') {
-		upper_inc = false;
-	} else {
-		throw InvalidInputException("Malformed range literal: \"%s\"", input_str);
+	RANGE Get(idx_t row) const {
+		RANGE range;
+		range.lower = lower_data[lower_format.sel->get_index(row)];
+		range.upper = upper_data[upper_format.sel->get_index(row)];
+		DecodeKinds(range, lower_kind_data[lower_kind_format.sel->get_index(row)],
+		            upper_kind_data[upper_kind_format.sel->get_index(row)]);
+		return range;
 	}
 
-	auto comma_pos = s.find(',');
-	if (comma_pos == string::npos) {
-		throw InvalidInputException("Malformed range literal: \"%s\" (missing comma)", input_str);
+	//! Whether the struct and all of its children are flat, so rows can be read without selection vectors
+	static bool IsFlat(Vector &input) {
+		if (input.GetVectorType() != VectorType::FLAT_VECTOR) {
+			return false;
+		}
+		for (auto &entry : StructVector::GetEntries(input)) {
+			if (entry->GetVectorType() != VectorType::FLAT_VECTOR) {
+				return false;
+			}
+		}
+		return true;
 	}
 
-	string lower_str = s.substr(1, comma_pos - 1);
-	string upper_str = s.substr(comma_pos + 1, s.length() - comma_pos - 2);
+	RANGE GetFlat(idx_t row) const {
+		RANGE range;
+		range.lower = lower_data[row];
+		range.upper = upper_data[row];
+		DecodeKinds(range, lower_kind_data[row], upper_kind_data[row]);
+		return range;
+	}
 
-	int32_t lower, upper;
-	try {
-		lower = std::stoi(lower_str);
-		upper = std::stoi(upper_str);
-	} catch (...) {
-		throw InvalidInputException("Invalid integer in range literal: \"%s\"", input_str);
+	const ValidityMask &Validity() const {
+		return format.validity;
 	}
 
-	return {lower, upper, lower_inc, upper_inc};
-}
+	UnifiedVectorFormat format;
+	UnifiedVectorFormat lower_format;
+	UnifiedVectorFormat lower_kind_format;
+	UnifiedVectorFormat upper_format;
+	UnifiedVectorFormat upper_kind_format;
+	const BOUND_TYPE *lower_data;
+	const uint8_t *lower_kind_data;
+	const BOUND_TYPE *upper_data;
+	const uint8_t *upper_kind_data;
+};
 
-static void Int4RangeConstructor4(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &lower_vec = args.data[0];
-	auto &upper_vec = args.data[1];
-	auto &lower_inc_vec = args.data[2];
-	auto &upper_inc_vec = args.data[3];
-	idx_t count = args.size();
+//! Reads plain values, mirroring the RangeReader interface
+template <class T>
+struct ValueReader {
+	ValueReader(Vector &input, idx_t count) {
+		input.ToUnifiedFormat(count, format);
+		data = UnifiedVectorFormat::GetData<T>(format);
+	}
 
-	UnifiedVectorFormat lower_data, upper_data, lower_inc_data, upper_inc_data;
-	lower_vec.ToUnifiedFormat(count, lower_data);
-	upper_vec.ToUnifiedFormat(count, upper_data);
-	lower_inc_vec.ToUnifiedFormat(count, lower_inc_data);
-	upper_inc_vec.ToUnifiedFormat(count, upper_inc_data);
+	bool RowIsValid(idx_t row) const {
+		return format.validity.RowIsValid(format.sel->get_index(row));
+	}
 
-	auto lower_ptr = UnifiedVectorFormat::GetData<int32_t>(lower_data);
-	auto upper_ptr = UnifiedVectorFormat::GetData<int32_t>(upper_data);
-	auto lower_inc_ptr = UnifiedVectorFormat::GetData<bool>(lower_inc_data);
-	auto upper_inc_ptr = UnifiedVectorFormat::GetData<bool>(upper_inc_data);
+	T Get(idx_t row) const {
+		return data[format.sel->get_index(row)];
+	}
 
-	for (idx_t i = 0; i < count; i++) {
-		idx_t lower_idx = lower_data.sel ? lower_data.sel->get_index(i) : i;
-		idx_t upper_idx = upper_data.sel ? upper_data.sel->get_index(i) : i;
-		idx_t lower_inc_idx = lower_inc_data.sel ? lower_inc_data.sel->get_index(i) : i;
-		idx_t upper_inc_idx = upper_inc_data.sel ? upper_inc_data.sel->get_index(i) : i;
+	static bool IsFlat(Vector &input) {
+		return input.GetVectorType() == VectorType::FLAT_VECTOR;
+	}
 
-		if (!lower_data.validity.RowIsValid(lower_idx) || !upper_data.validity.RowIsValid(upper_idx) ||
-		    !lower_inc_data.validity.RowIsValid(lower_inc_idx) || !upper_inc_data.validity.RowIsValid(upper_inc_idx)) {
-			FlatVector::SetNull(result, i, true);
-			continue;
-		}
+	T GetFlat(idx_t row) const {
+		return data[row];
+	}
 
-		auto serialized = ConstructInt4RangeValue(result, lower_ptr[lower_idx], upper_ptr[upper_idx],
-		                                          lower_inc_ptr[lower_inc_idx], upper_inc_ptr[upper_inc_idx]);
-		FlatVector::GetData<string_t>(result)[i] = serialized;
+	const ValidityMask &Validity() const {
+		return format.validity;
 	}
-}
 
-static void Int4RangeConstructor(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &lower_vec = args.data[0];
-	auto &upper_vec = args.data[1];
-	auto &bounds_vec = args.data[2];
+	UnifiedVectorFormat format;
+	const T *data;
+};
 
-	TernaryExecutor::Execute<int32_t, int32_t, string_t, string_t>(
-	    lower_vec, upper_vec, bounds_vec, result, args.size(), [&](int32_t lower, int32_t upper, string_t bounds_blob) {
-		    string bounds_str = bounds_blob.GetString();
-		    bool lower_inc = true;
-		    bool upper_inc = false;
-
-		    if (!bounds_str.empty()) {
-			    if (bounds_str == "[)") {
-				    lower_inc = true;
-				    upper_inc = false;
-			    } else if (bounds_str == "[]") {
-				    lower_inc = true;
-				    upper_inc = true;
-			    } else if (bounds_str == "(]") {
-				    lower_inc = false;
-				    upper_inc = true;
-			    } else if (bounds_str == "()") {
-				    lower_inc = false;
-				    upper_inc = false;
-			    } else {
-				    throw InvalidInputException("Invalid bounds: " + bounds_str);
-			    }
-		    }
+// Ranges of discrete subtypes are stored in the canonical [lower, upper) form, like PostgreSQL's int4range, so
+// equal ranges are bitwise identical and DuckDB's native struct equality, hashing, GROUP BY and hash joins are
+// exact. Only a range ending at the highest value keeps an inclusive upper bound, as its successor is not
+// representable. Continuous subtypes keep their bounds as given. For all subtypes every empty range collapses
+// to a single encoding (RANGE_EMPTY_KIND and the lowest bound value) that sorts before all other ranges, and
+// infinite bounds are set to the lowest/highest value. CanonicalizeRange returns false if the range is empty.
 
-		    return ConstructInt4RangeValue(result, lower, upper, lower_inc, upper_inc);
-	    });
+template <class T>
+static inline Range<T> EmptyRange() {
+	return Range<T> {RangeTraits<T>::Lowest(), RangeTraits<T>::Lowest(), false, false};
 }
 
-static bool Int4RangeToVarchar(Vector &source, Vector &result, idx_t count, CastParameters &parameters) {
-	UnifiedVectorFormat source_data;
-	source.ToUnifiedFormat(count, source_data);
-	auto source_ptr = UnifiedVectorFormat::GetData<string_t>(source_data);
-
-	for (idx_t i = 0; i < count; i++) {
-		auto idx = source_data.sel->get_index(i);
-		if (!source_data.validity.RowIsValid(idx)) {
-			FlatVector::SetNull(result, i, true);
-			continue;
-		}
-
-		auto range = DeserializeInt4Range(source_ptr[idx]);
-		string str;
-		if (IsEmpty(range)) {
-			str = "empty";
-		} else {
-			str = (range.lower_inc ? "[" : "(") + std::to_string(range.lower) + "," + std::to_string(range.upper) +
-			      (range.upper_inc ? "]" : ")");
+template <class T>
+static inline bool CanonicalizeRange(Range<T> &range, std::true_type discrete) {
+	using TRAITS = RangeTraits<T>;
+	if (!range.lower_inc) {
+		if (range.lower == TRAITS::Highest()) {
+			range = EmptyRange<T>();
+			return false;
 		}
-		FlatVector::GetData<string_t>(result)[i] = StringVector::AddString(result, str);
+		range.lower = TRAITS::Successor(range.lower);
+		range.lower_inc = true;
+	}
+	if (range.upper_inc && range.upper != TRAITS::Highest()) {
+		range.upper = TRAITS::Successor(range.upper);
+		range.upper_inc = false;
+	}
+	if (range.upper_inc ? range.lower > range.upper : range.lower >= range.upper) {
+		range = EmptyRange<T>();
+		return false;
 	}
 	return true;
 }
 
-static bool VarcharToInt4RangeCast(Vector &source, Vector &result, idx_t count, CastParameters &parameters) {
-	UnifiedVectorFormat source_data;
-	source.ToUnifiedFormat(count, source_data);
-	auto source_ptr = UnifiedVectorFormat::GetData<string_t>(source_data);
-
-	for (idx_t i = 0; i < count; i++) {
-		auto idx = source_data.sel->get_index(i);
-		if (!source_data.validity.RowIsValid(idx)) {
-			FlatVector::SetNull(result, i, true);
-			continue;
-		}
-
-		Int4Range range = ParseInt4Range(source_ptr[idx].GetString());
-		auto serialized = SerializeInt4Range(range, result);
-		FlatVector::GetData<string_t>(result)[i] = serialized;
+template <class T>
+static inline bool CanonicalizeRange(Range<T> &range, std::false_type discrete) {
+	if (range.lower > range.upper || (range.lower == range.upper && !(range.lower_inc && range.upper_inc))) {
+		range = EmptyRange<T>();
+		return false;
 	}
 	return true;
 }
 
-// 1-arg constructor: int4range(varchar)
-static void Int4RangeConstructor1(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &input_vec = args.data[0];
-	UnaryExecutor::Execute<string_t, string_t>(input_vec, result, args.size(), [&](string_t input) {
-		Int4Range range = ParseInt4Range(input.GetString());
-		return SerializeInt4Range(range, result);
-	});
+template <class T>
+static inline bool CanonicalizeRange(Range<T> &range) {
+	if (range.lower_inf) {
+		range.lower = RangeTraits<T>::Lowest();
+		range.lower_inc = true;
+	}
+	if (range.upper_inf) {
+		range.upper = RangeTraits<T>::Highest();
+		range.upper_inc = true;
+	}
+	return CanonicalizeRange(range, std::integral_constant<bool, RangeTraits<T>::DISCRETE>());
 }
 
-static void RangeOverlaps(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &r1_vec = args.data[0];
-	auto &r2_vec = args.data[1];
+//! Writes ranges in their canonical form into the (flat) children of a range STRUCT vector
+template <class RANGE>
+struct RangeWriter {
+	using BOUND_TYPE = decltype(RANGE::lower);
+
+	explicit RangeWriter(Vector &result) {
+		auto &entries = StructVector::GetEntries(result);
+		lower_data = FlatVector::GetData<BOUND_TYPE>(*entries[RANGE_LOWER_INDEX]);
+		lower_kind_data = FlatVector::GetData<uint8_t>(*entries[RANGE_LOWER_KIND_INDEX]);
+		upper_data = FlatVector::GetData<BOUND_TYPE>(*entries[RANGE_UPPER_INDEX]);
+		upper_kind_data = FlatVector::GetData<uint8_t>(*entries[RANGE_UPPER_KIND_INDEX]);
+	}
 
-	BinaryExecutor::Execute<string_t, string_t, bool>(
-	    r1_vec, r2_vec, result, args.size(), [&](string_t r1_blob, string_t r2_blob) {
-		    auto r1 = DeserializeInt4Range(r1_blob);
-		    auto r2 = DeserializeInt4Range(r2_blob);
+	void Set(idx_t row, const RANGE &range) {
+		auto canonical = range;
+		auto non_empty = CanonicalizeRange(canonical);
+		lower_data[row] = canonical.lower;
+		upper_data[row] = canonical.upper;
+		lower_kind_data[row] = non_empty ? LowerKind(canonical.lower_inc, canonical.lower_inf) : RANGE_EMPTY_KIND;
+		upper_kind_data[row] = non_empty ? UpperKind(canonical.upper_inc, canonical.upper_inf) : RANGE_EMPTY_KIND;
+	}
 
-		    if (IsEmpty(r1) || IsEmpty(r2))
-			    return false;
+	BOUND_TYPE *lower_data;
+	uint8_t *lower_kind_data;
+	BOUND_TYPE *upper_data;
+	uint8_t *upper_kind_data;
+};
 
-		    // Overlap logic: not (r1 entirely left of r2 or r1 entirely right of r2)
-		    // r1 left of r2: r1.upper < r2.lower OR (r1.upper == r2.lower AND (!r1.upper_inc OR
-		    // !r2.lower_inc))
+//! Writes plain values, mirroring the RangeWriter interface
+template <class T>
+struct ValueWriter {
+	explicit ValueWriter(Vector &result) : data(FlatVector::GetData<T>(result)) {
+	}
 
-		    bool r1_left_of_r2 = (r1.upper < r2.lower) || (r1.upper == r2.lower && (!r1.upper_inc || !r2.lower_inc));
-		    bool r2_left_of_r1 = (r2.upper < r1.lower) || (r2.upper == r1.lower && (!r2.upper_inc || !r1.lower_inc));
+	void Set(idx_t row, const T &value) {
+		data[row] = value;
+	}
 
-		    return !(r1_left_of_r2 || r2_left_of_r1);
-	    });
+	T *data;
+};
+
+// A multirange is a LIST of ranges with a type alias. Its elements are kept sorted, disjoint, non-adjacent and
+// non-empty, so containment is a binary search and set operations are linear merges.
+
+static LogicalType MakeMultirangeType(const LogicalType &range_type, const string &alias) {
+	auto type = LogicalType::LIST(range_type);
+	type.SetAlias(alias);
+	return type;
 }
 
-// Aggressively optimized inline containment check for hot path (JOIN operations)
-// This is the critical path for pricing grid matching queries
-static inline bool ContainsValue(const Int4Range &range, int32_t value) {
-	// Branch-free fast rejection: value outside [lower, upper]
-	// This handles 90%+ of cases in typical pricing grid queries
-	const bool outside = (value < range.lower) | (value > range.upper);
-	if (outside) [[unlikely]] {
-		return false;
+//! Reads the ranges of multirange (or plain range LIST) rows
+template <class RANGE>
+struct MultirangeReader {
+	MultirangeReader(Vector &input, idx_t count)
+	    : lists(input, count), ranges(ListVector::GetEntry(input), ListVector::GetListSize(input)) {
 	}
 
-	// Value is within [lower, upper], now check boundary inclusivity
-	// Common case: value is strictly inside, not on boundaries
-	const bool on_lower = (value == range.lower);
-	const bool on_upper = (value == range.upper);
+	bool RowIsValid(idx_t row) const {
+		return lists.RowIsValid(row);
+	}
 
-	// Fast path: not on any boundary (most common in pricing grids)
-	if (!(on_lower | on_upper)) [[likely]] {
-		return true;
+	//! Collects the non-NULL elements of a row into result
+	void Get(idx_t row, vector<RANGE> &result) const {
+		auto entry = lists.Get(row);
+		result.clear();
+		for (idx_t i = entry.offset; i < entry.offset + entry.length; i++) {
+			if (ranges.RowIsValid(i)) {
+				result.push_back(ranges.Get(i));
+			}
+		}
 	}
 
-	// Boundary cases: check inclusivity flags
-	// Use bitwise operations to avoid branches
-	return (!on_lower | range.lower_inc) & (!on_upper | range.upper_inc);
-}
+	ValueReader<list_entry_t> lists;
+	RangeReader<RANGE> ranges;
+};
 
-static void RangeContains(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &range_vec = args.data[0];
-	auto &value_vec = args.data[1];
+//! Appends lists of ranges to a multirange (or range LIST) result vector
+template <class RANGE>
+struct MultirangeWriter {
+	explicit MultirangeWriter(Vector &result) : result(result) {
+	}
+
+	void Set(idx_t row, const vector<RANGE> &ranges) {
+		auto offset = ListVector::GetListSize(result);
+		ListVector::Reserve(result, offset + ranges.size());
+		// Reserve can reallocate the child, so the range writer is set up afterwards
+		RangeWriter<RANGE> writer(ListVector::GetEntry(result));
+		for (idx_t i = 0; i < ranges.size(); i++) {
+			writer.Set(offset + i, ranges[i]);
+		}
+		ListVector::SetListSize(result, offset + ranges.size());
+		FlatVector::GetData<list_entry_t>(result)[row] = list_entry_t(offset, ranges.size());
+	}
+
+	Vector &result;
+};
 
-	BinaryExecutor::Execute<string_t, int32_t, bool>(range_vec, value_vec, result, args.size(),
-	                                                 [&](string_t range_blob, int32_t value) {
-		                                                 auto range = DeserializeInt4Range(range_blob);
-		                                                 return ContainsValue(range, value);
-	                                                 });
+//! Runs FUN for every valid row of a flat input, marking the other rows NULL
+template <class READER, class FUN>
+static void ExecuteFlatRows(const READER &reader, Vector &result, idx_t count, FUN &&fun) {
+	auto &validity = reader.Validity();
+	if (validity.AllValid()) {
+		for (idx_t i = 0; i < count; i++) {
+			fun(i);
+		}
+		return;
+	}
+	for (idx_t i = 0; i < count; i++) {
+		if (!validity.RowIsValid(i)) {
+			FlatVector::SetNull(result, i, true);
+			continue;
+		}
+		fun(i);
+	}
 }
 
-static void RangeContainedBy(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &value_vec = args.data[0];
-	auto &range_vec = args.data[1];
+// Unary/binary executors over range vectors. A NULL in any input produces NULL, and constant inputs
+// produce a constant result, like DuckDB's own UnaryExecutor/BinaryExecutor.
+template <class A_READER, class WRITER, class OP>
+static void ExecuteRangeUnary(Vector &a_vec, Vector &result, idx_t count, OP &&op) {
+	A_READER a(a_vec, count);
+	auto is_constant = a_vec.GetVectorType() == VectorType::CONSTANT_VECTOR;
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	WRITER writer(result);
+	if (!is_constant && A_READER::IsFlat(a_vec)) {
+		ExecuteFlatRows(a, result, count, [&](idx_t i) { writer.Set(i, op(a.GetFlat(i))); });
+		return;
+	}
+	auto row_count = is_constant ? 1 : count;
+	for (idx_t i = 0; i < row_count; i++) {
+		if (!a.RowIsValid(i)) {
+			FlatVector::SetNull(result, i, true);
+			continue;
+		}
+		writer.Set(i, op(a.Get(i)));
+	}
+	if (is_constant) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	}
+}
+
+template <class A_READER, class B_READER, class WRITER, class OP>
+static void ExecuteRangeBinary(Vector &a_vec, Vector &b_vec, Vector &result, idx_t count, OP &&op) {
+	A_READER a(a_vec, count);
+	B_READER b(b_vec, count);
+	auto a_constant = a_vec.GetVectorType() == VectorType::CONSTANT_VECTOR;
+	auto b_constant = b_vec.GetVectorType() == VectorType::CONSTANT_VECTOR;
+	if ((a_constant && !a.RowIsValid(0)) || (b_constant && !b.RowIsValid(0))) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+		ConstantVector::SetNull(result, true);
+		return;
+	}
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	WRITER writer(result);
+	// One constant side: decode it once and stream the other side straight from its flat children
+	if (a_constant && !b_constant && B_READER::IsFlat(b_vec)) {
+		auto a_value = a.Get(0);
+		ExecuteFlatRows(b, result, count, [&](idx_t i) { writer.Set(i, op(a_value, b.GetFlat(i))); });
+		return;
+	}
+	if (b_constant && !a_constant && A_READER::IsFlat(a_vec)) {
+		auto b_value = b.Get(0);
+		ExecuteFlatRows(a, result, count, [&](idx_t i) { writer.Set(i, op(a.GetFlat(i), b_value)); });
+		return;
+	}
+	// Both sides flat: the bounds are already laid out as dense lower[]/upper[]/kind[] arrays, so the loop
+	// reads them directly and the compiler can vectorize the predicate
+	if (!a_constant && !b_constant && A_READER::IsFlat(a_vec) && B_READER::IsFlat(b_vec)) {
+		auto &a_validity = a.Validity();
+		auto &b_validity = b.Validity();
+		if (a_validity.AllValid() && b_validity.AllValid()) {
+			for (idx_t i = 0; i < count; i++) {
+				writer.Set(i, op(a.GetFlat(i), b.GetFlat(i)));
+			}
+			return;
+		}
+		for (idx_t i = 0; i < count; i++) {
+			if (!a_validity.RowIsValid(i) || !b_validity.RowIsValid(i)) {
+				FlatVector::SetNull(result, i, true);
+				continue;
+			}
+			writer.Set(i, op(a.GetFlat(i), b.GetFlat(i)));
+		}
+		return;
+	}
+	auto is_constant = a_constant && b_constant;
+	auto row_count = is_constant ? 1 : count;
+	for (idx_t i = 0; i < row_count; i++) {
+		if (!a.RowIsValid(i) || !b.RowIsValid(i)) {
+			FlatVector::SetNull(result, i, true);
+			continue;
+		}
+		writer.Set(i, op(a.Get(i), b.Get(i)));
+	}
+	if (is_constant) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	}
+}
 
-	BinaryExecutor::Execute<int32_t, string_t, bool>(value_vec, range_vec, result, args.size(),
-	                                                 [&](int32_t value, string_t range_blob) {
-		                                                 auto range = DeserializeInt4Range(range_blob);
-		                                                 return ContainsValue(range, value);
-	                                                 });
+// Repetitive text columns, such as band labels, are scanned from dictionary-compressed storage (or Parquet
+// dictionary pages) as dictionary vectors with a known dictionary size. Parsing them can then be done once per
+// distinct string instead of once per row, returning the parsed values as a dictionary over the same selection.
+// Only worthwhile when each entry is shared by a few rows, as for DuckDB's own dictionary execution.
+static constexpr idx_t DICTIONARY_EXECUTION_MIN_ROWS_PER_ENTRY = 2;
+
+//! Parses the entries of a dictionary-encoded VARCHAR vector with parse(entry, writer, index). Returns false if
+//! the input is not such a dictionary, or if some entry fails to parse: an entry may not be referenced by any row
+//! (e.g. after a filter), so the caller redoes the rows to report (or NULL) only the failures that matter.
+template <class WRITER, class PARSE>
+static bool ExecuteParseDictionary(Vector &source, Vector &result, idx_t count, PARSE &&parse) {
+	if (source.GetVectorType() != VectorType::DICTIONARY_VECTOR) {
+		return false;
+	}
+	auto dictionary_size = DictionaryVector::DictionarySize(source);
+	if (!dictionary_size.IsValid() ||
+	    dictionary_size.GetIndex() * DICTIONARY_EXECUTION_MIN_ROWS_PER_ENTRY > count) {
+		return false;
+	}
+	auto entry_count = dictionary_size.GetIndex();
+	ValueReader<string_t> entries(DictionaryVector::Child(source), entry_count);
+	Vector parsed(result.GetType(), entry_count);
+	WRITER writer(parsed);
+	for (idx_t i = 0; i < entry_count; i++) {
+		if (!entries.RowIsValid(i)) {
+			FlatVector::SetNull(parsed, i, true);
+			continue;
+		}
+		if (!parse(entries.Get(i), writer, i)) {
+			return false;
+		}
+	}
+	result.Dictionary(parsed, entry_count, DictionaryVector::SelVector(source), count);
+	return true;
 }
 
 //===--------------------------------------------------------------------===//
-// Comparison Operators for Range Ordering (enables sorting/indexing)
+// Statistics Counters
 //===--------------------------------------------------------------------===//
+// With `SET ranges_stats = true`, every range function counts the chunks and rows it processes and the vector
+// types of its arguments, the casts count their rows, parse errors and rendered bytes, and range_lookup and
+// range_bucket count the hits and misses of their index cache when bound. `FROM ranges_stats()` reports the
+// counters, which belong to the database and restart from zero whenever the setting is switched on. The setting
+// is read from the client context when an expression is set up, so it follows the scope it was set in and RESET;
+// the resulting site is kept in the expression's local state, so each chunk pays one pointer check and nothing
+// per row while counting is off.
+
+enum class RangeStatsCounter : uint8_t {
+	CHUNKS,
+	ROWS,
+	CONSTANT_CHUNKS,
+	FLAT_CHUNKS,
+	DICTIONARY_CHUNKS,
+	PARSE_ERRORS,
+	TEXT_BYTES,
+	CACHE_HITS,
+	CACHE_MISSES,
+	COUNTER_COUNT
+};
+
+static constexpr idx_t RANGE_STATS_COUNTER_COUNT = idx_t(RangeStatsCounter::COUNTER_COUNT);
+static const char *const RANGE_STATS_COUNTER_NAMES[RANGE_STATS_COUNTER_COUNT] = {
+    "chunks",       "rows",       "constant_chunks", "flat_chunks", "dictionary_chunks",
+    "parse_errors", "text_bytes", "cache_hits",      "cache_misses"};
 
-static inline int CompareRanges(const Int4Range &r1, const Int4Range &r2) {
-	// Empty ranges are considered equal
-	if (IsEmpty(r1) && IsEmpty(r2)) {
-		return 0;
+//! The counters of one function or cast
+struct RangeStatsSite {
+	explicit RangeStatsSite(string name_p) : name(std::move(name_p)) {
+		Reset();
 	}
-	// Empty range is less than non-empty
-	if (IsEmpty(r1)) {
-		return -1;
+
+	void Add(RangeStatsCounter counter, uint64_t amount) {
+		counters[idx_t(counter)].fetch_add(amount, std::memory_order_relaxed);
 	}
-	if (IsEmpty(r2)) {
-		return 1;
+
+	void Reset() {
+		for (auto &counter : counters) {
+			counter.store(0, std::memory_order_relaxed);
+		}
 	}
-	// Compare lower bounds first
-	if (r1.lower < r2.lower) {
-		return -1;
+
+	string name;
+	atomic<uint64_t> counters[RANGE_STATS_COUNTER_COUNT];
+};
+
+//! The counters of one database, kept in its object cache
+class RangeStatsState : public ObjectCacheEntry {
+public:
+	static string ObjectType() {
+		return "ranges_stats";
 	}
-	if (r1.lower > r2.lower) {
-		return 1;
+	string GetObjectType() override {
+		return ObjectType();
 	}
-	// Lower bounds equal, check inclusivity (inclusive < exclusive)
-	if (r1.lower_inc && !r2.lower_inc) {
-		return -1;
+	//! Never evicted, the counters would be lost
+	optional_idx GetEstimatedCacheMemory() const override {
+		return optional_idx();
 	}
-	if (!r1.lower_inc && r2.lower_inc) {
-		return 1;
+
+	static shared_ptr<RangeStatsState> Get(ClientContext &context) {
+		return ObjectCache::GetObjectCache(context).GetOrCreate<RangeStatsState>(ObjectType());
 	}
-	// Lower bounds identical, compare upper bounds
-	if (r1.upper < r2.upper) {
-		return -1;
+
+	//! Whether the ranges_stats setting is on, in the scope that applies to context
+	static bool IsEnabled(ClientContext &context) {
+		Value enabled;
+		return context.TryGetCurrentSetting("ranges_stats", enabled) && !enabled.IsNull() && enabled.GetValue<bool>();
 	}
-	if (r1.upper > r2.upper) {
-		return 1;
+
+	void Reset() {
+		lock_guard<mutex> guard(lock);
+		for (auto &site : sites) {
+			site->Reset();
+		}
 	}
-	// Upper bounds equal, check inclusivity (exclusive < inclusive)
-	if (!r1.upper_inc && r2.upper_inc) {
-		return -1;
+
+	//! The counters of the site called name, created on first use. Sites live as long as the database, so the
+	//! reference can be kept along with the state.
+	RangeStatsSite &Site(const string &name) {
+		lock_guard<mutex> guard(lock);
+		for (auto &site : sites) {
+			if (site->name == name) {
+				return *site;
+			}
+		}
+		sites.push_back(make_uniq<RangeStatsSite>(name));
+		return *sites.back();
 	}
-	if (r1.upper_inc && !r2.upper_inc) {
-		return 1;
+
+	//! Calls callback(site, counter, value) for every non-zero counter
+	template <class CALLBACK>
+	void Scan(CALLBACK &&callback) {
+		lock_guard<mutex> guard(lock);
+		for (auto &site : sites) {
+			for (idx_t i = 0; i < RANGE_STATS_COUNTER_COUNT; i++) {
+				auto value = site->counters[i].load(std::memory_order_relaxed);
+				if (value != 0) {
+					callback(site->name, RANGE_STATS_COUNTER_NAMES[i], value);
+				}
+			}
+		}
 	}
-	return 0;
-}
 
-static void RangeLessThan(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &r1_vec = args.data[0];
-	auto &r2_vec = args.data[1];
+private:
+	mutex lock;
+	vector<unique_ptr<RangeStatsSite>> sites;
+};
 
-	BinaryExecutor::Execute<string_t, string_t, bool>(r1_vec, r2_vec, result, args.size(),
-	                                                  [&](string_t r1_blob, string_t r2_blob) {
-		                                                  auto r1 = DeserializeInt4Range(r1_blob);
-		                                                  auto r2 = DeserializeInt4Range(r2_blob);
-		                                                  return CompareRanges(r1, r2) < 0;
-	                                                  });
-}
+//! Local state of a counted function or cast: its site in the counters of the database, or none if counting was
+//! off when the expression was set up
+struct RangeStatsLocalState : public FunctionLocalState {
+	shared_ptr<RangeStatsState> stats;
+	optional_ptr<RangeStatsSite> site;
+};
 
-static void RangeLessThanEquals(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &r1_vec = args.data[0];
-	auto &r2_vec = args.data[1];
+static unique_ptr<FunctionLocalState> InitRangeStatsLocalState(ClientContext &context, const string &site_name) {
+	auto result = make_uniq<RangeStatsLocalState>();
+	result->stats = RangeStatsState::Get(context);
+	result->site = &result->stats->Site(site_name);
+	return std::move(result);
+}
 
-	BinaryExecutor::Execute<string_t, string_t, bool>(r1_vec, r2_vec, result, args.size(),
-	                                                  [&](string_t r1_blob, string_t r2_blob) {
-		                                                  auto r1 = DeserializeInt4Range(r1_blob);
-		                                                  auto r2 = DeserializeInt4Range(r2_blob);
-		                                                  return CompareRanges(r1, r2) <= 0;
-	                                                  });
+//! Counts a chunk of a range function along with the path its arguments take through the kernels: all
+//! constant, some dictionary-encoded, or otherwise flat
+static void RecordRangeChunk(RangeStatsSite &site, DataChunk &args) {
+	bool all_constant = true;
+	bool any_dictionary = false;
+	for (auto &arg : args.data) {
+		all_constant = all_constant && arg.GetVectorType() == VectorType::CONSTANT_VECTOR;
+		any_dictionary = any_dictionary || arg.GetVectorType() == VectorType::DICTIONARY_VECTOR;
+	}
+	site.Add(RangeStatsCounter::CHUNKS, 1);
+	site.Add(RangeStatsCounter::ROWS, args.size());
+	site.Add(all_constant     ? RangeStatsCounter::CONSTANT_CHUNKS
+	         : any_dictionary ? RangeStatsCounter::DICTIONARY_CHUNKS
+	                          : RangeStatsCounter::FLAT_CHUNKS,
+	         1);
 }
 
-static void RangeGreaterThan(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &r1_vec = args.data[0];
-	auto &r2_vec = args.data[1];
+//! The site name of a function overload, with its argument types so that each range type is counted apart,
+//! e.g. isempty(INT4RANGE) or @>(INT4MULTIRANGE, INTEGER)
+static string RangeStatsSiteName(const ScalarFunction &function) {
+	auto name = function.name + "(";
+	for (idx_t i = 0; i < function.arguments.size(); i++) {
+		if (i > 0) {
+			name += ", ";
+		}
+		name += function.arguments[i].ToString();
+	}
+	return name + ")";
+}
 
-	BinaryExecutor::Execute<string_t, string_t, bool>(r1_vec, r2_vec, result, args.size(),
-	                                                  [&](string_t r1_blob, string_t r2_blob) {
-		                                                  auto r1 = DeserializeInt4Range(r1_blob);
-		                                                  auto r2 = DeserializeInt4Range(r2_blob);
-		                                                  return CompareRanges(r1, r2) > 0;
-	                                                  });
+static unique_ptr<FunctionLocalState> InitRangeFunctionStats(ExpressionState &state,
+                                                              const BoundFunctionExpression &expr,
+                                                              FunctionData *bind_data) {
+	if (!state.HasContext() || !RangeStatsState::IsEnabled(state.GetContext())) {
+		return make_uniq<RangeStatsLocalState>();
+	}
+	return InitRangeStatsLocalState(state.GetContext(), RangeStatsSiteName(expr.function));
 }
 
-static void RangeGreaterThanEquals(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &r1_vec = args.data[0];
-	auto &r2_vec = args.data[1];
+//! Wraps the kernel of a scalar function so that its chunks are counted under the overload's site name
+static ScalarFunction WithRangeStats(ScalarFunction function) {
+	D_ASSERT(!function.init_local_state);
+	function.init_local_state = InitRangeFunctionStats;
+	auto kernel = std::move(function.function);
+	function.function = [kernel](DataChunk &args, ExpressionState &state, Vector &result) {
+		auto local_state = ExecuteFunctionState::GetFunctionState(state);
+		if (local_state && local_state->Cast<RangeStatsLocalState>().site) {
+			RecordRangeChunk(*local_state->Cast<RangeStatsLocalState>().site, args);
+		}
+		kernel(args, state, result);
+	};
+	return function;
+}
 
-	BinaryExecutor::Execute<string_t, string_t, bool>(r1_vec, r2_vec, result, args.size(),
-	                                                  [&](string_t r1_blob, string_t r2_blob) {
-		                                                  auto r1 = DeserializeInt4Range(r1_blob);
-		                                                  auto r2 = DeserializeInt4Range(r2_blob);
-		                                                  return CompareRanges(r1, r2) >= 0;
-	                                                  });
+static void RegisterRangeFunction(ExtensionLoader &loader, ScalarFunction function) {
+	loader.RegisterFunction(WithRangeStats(std::move(function)));
 }
 
-static void RangeEquals(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &r1_vec = args.data[0];
-	auto &r2_vec = args.data[1];
+//! Cast data of a counted cast: the name of its site, "source -> target"
+struct RangeCastStatsData : public BoundCastData {
+	explicit RangeCastStatsData(string site_name_p) : site_name(std::move(site_name_p)) {
+	}
 
-	BinaryExecutor::Execute<string_t, string_t, bool>(r1_vec, r2_vec, result, args.size(),
-	                                                  [&](string_t r1_blob, string_t r2_blob) {
-		                                                  auto r1 = DeserializeInt4Range(r1_blob);
-		                                                  auto r2 = DeserializeInt4Range(r2_blob);
-		                                                  return CompareRanges(r1, r2) == 0;
-	                                                  });
-}
+	string site_name;
 
-static void RangeNotEquals(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &r1_vec = args.data[0];
-	auto &r2_vec = args.data[1];
+	unique_ptr<BoundCastData> Copy() const override {
+		return make_uniq<RangeCastStatsData>(site_name);
+	}
+};
 
-	BinaryExecutor::Execute<string_t, string_t, bool>(r1_vec, r2_vec, result, args.size(),
-	                                                  [&](string_t r1_blob, string_t r2_blob) {
-		                                                  auto r1 = DeserializeInt4Range(r1_blob);
-		                                                  auto r2 = DeserializeInt4Range(r2_blob);
-		                                                  return CompareRanges(r1, r2) != 0;
-	                                                  });
+static unique_ptr<FunctionLocalState> InitRangeCastStats(CastLocalStateParameters &parameters) {
+	if (!parameters.context || !RangeStatsState::IsEnabled(*parameters.context)) {
+		return make_uniq<RangeStatsLocalState>();
+	}
+	auto &cast_data = parameters.cast_data->Cast<RangeCastStatsData>();
+	return InitRangeStatsLocalState(*parameters.context, cast_data.site_name);
 }
 
-// Accessor: lower(INT4RANGE) -> INTEGER
-static void RangeLower(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &range_vec = args.data[0];
-	UnaryExecutor::Execute<string_t, int32_t>(range_vec, result, args.size(), [&](string_t range_blob) {
-		auto range = DeserializeInt4Range(range_blob);
-		return range.lower;
-	});
+//! The cast function of a counted cast, whose counters are named site_name
+static BoundCastInfo RangeCastInfo(cast_function_t function, string site_name) {
+	return BoundCastInfo(function, make_uniq<RangeCastStatsData>(std::move(site_name)), InitRangeCastStats);
 }
 
-// Accessor: upper(INT4RANGE) -> INTEGER
-static void RangeUpper(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &range_vec = args.data[0];
-	UnaryExecutor::Execute<string_t, int32_t>(range_vec, result, args.size(), [&](string_t range_blob) {
-		auto range = DeserializeInt4Range(range_blob);
-		return range.upper;
-	});
+//! The site of a cast, or nullptr when not counting
+static optional_ptr<RangeStatsSite> RangeCastStatsSite(CastParameters &parameters) {
+	if (!parameters.local_state) {
+		return nullptr;
+	}
+	return parameters.local_state->Cast<RangeStatsLocalState>().site;
 }
 
-// Accessor: isempty(INT4RANGE) -> BOOLEAN
-static void RangeIsEmpty(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &range_vec = args.data[0];
-	UnaryExecutor::Execute<string_t, bool>(range_vec, result, args.size(), [&](string_t range_blob) {
-		auto range = DeserializeInt4Range(range_blob);
-		return IsEmpty(range);
-	});
+//! Counts a chunk of a cast
+static void RecordRangeCast(CastParameters &parameters, idx_t rows, uint64_t parse_errors, uint64_t text_bytes) {
+	auto site = RangeCastStatsSite(parameters);
+	if (!site) {
+		return;
+	}
+	site->Add(RangeStatsCounter::CHUNKS, 1);
+	site->Add(RangeStatsCounter::ROWS, rows);
+	site->Add(RangeStatsCounter::PARSE_ERRORS, parse_errors);
+	site->Add(RangeStatsCounter::TEXT_BYTES, text_bytes);
 }
 
-// Accessor: lower_inc(INT4RANGE) -> BOOLEAN
-static void RangeLowerInc(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &range_vec = args.data[0];
-	UnaryExecutor::Execute<string_t, bool>(range_vec, result, args.size(), [&](string_t range_blob) {
-		auto range = DeserializeInt4Range(range_blob);
-		return range.lower_inc;
-	});
+//! Setter of the ranges_stats setting: switching it on restarts the counters of the database from zero. RESET
+//! does not call it, but counting follows the setting as read when each expression is set up.
+static void SetRangeStats(ClientContext &context, SetScope scope, Value &parameter) {
+	if (!parameter.IsNull() && parameter.GetValue<bool>()) {
+		RangeStatsState::Get(context)->Reset();
+	}
 }
 
-// Accessor: upper_inc(INT4RANGE) -> BOOLEAN
-static void RangeUpperInc(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &range_vec = args.data[0];
-	UnaryExecutor::Execute<string_t, bool>(range_vec, result, args.size(), [&](string_t range_blob) {
-		auto range = DeserializeInt4Range(range_blob);
-		return range.upper_inc;
-	});
-}
+struct RangeStatsScanState : public GlobalTableFunctionState {
+	RangeStatsScanState() : offset(0) {
+	}
 
-// 2-arg constructor: int4range(lower, upper) with default bounds '[)'
-static void Int4RangeConstructor2(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &lower_vec = args.data[0];
-	auto &upper_vec = args.data[1];
+	vector<string> sites;
+	vector<string> counters;
+	vector<uint64_t> values;
+	idx_t offset;
+};
 
-	BinaryExecutor::Execute<int32_t, int32_t, string_t>(
-	    lower_vec, upper_vec, result, args.size(),
-	    [&](int32_t lower, int32_t upper) { return ConstructInt4RangeValue(result, lower, upper, true, false); });
+//! ranges_stats() -> TABLE(name VARCHAR, counter VARCHAR, value UBIGINT)
+static unique_ptr<FunctionData> BindRangeStats(ClientContext &context, TableFunctionBindInput &input,
+                                               vector<LogicalType> &return_types, vector<string> &names) {
+	names.emplace_back("name");
+	return_types.push_back(LogicalType::VARCHAR);
+	names.emplace_back("counter");
+	return_types.push_back(LogicalType::VARCHAR);
+	names.emplace_back("value");
+	return_types.push_back(LogicalType::UBIGINT);
+	return nullptr;
 }
 
-//===--------------------------------------------------------------------===//
-// NUMRANGE Implementation
-//===--------------------------------------------------------------------===//
-
-LogicalType GetNumRangeType() {
-	auto type = LogicalType(LogicalTypeId::BLOB);
-	type.SetAlias("NUMRANGE");
-	return type;
+static unique_ptr<GlobalTableFunctionState> InitRangeStats(ClientContext &context, TableFunctionInitInput &input) {
+	auto state = make_uniq<RangeStatsScanState>();
+	RangeStatsState::Get(context)->Scan([&](const string &site, const char *counter, uint64_t value) {
+		state->sites.push_back(site);
+		state->counters.emplace_back(counter);
+		state->values.push_back(value);
+	});
+	return std::move(state);
 }
 
-static string_t SerializeNumRange(const NumRange &range, Vector &result) {
-	const size_t size = sizeof(double) * 2 + sizeof(uint8_t);
-	auto data = StringVector::EmptyString(result, size);
-	auto ptr = data.GetDataWriteable();
-	memcpy(ptr, &range.lower, sizeof(double));
-	memcpy(ptr + sizeof(double), &range.upper, sizeof(double));
-	uint8_t bounds = (range.lower_inc ? 0b10 : 0) | (range.upper_inc ? 0b01 : 0);
-	memcpy(ptr + sizeof(double) * 2, &bounds, sizeof(uint8_t));
-	return data;
+static void RangeStatsFunction(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	auto &state = data.global_state->Cast<RangeStatsScanState>();
+	idx_t count = 0;
+	while (state.offset < state.values.size() && count < STANDARD_VECTOR_SIZE) {
+		output.SetValue(0, count, Value(state.sites[state.offset]));
+		output.SetValue(1, count, Value(state.counters[state.offset]));
+		output.SetValue(2, count, Value::UBIGINT(state.values[state.offset]));
+		state.offset++;
+		count++;
+	}
+	output.SetCardinality(count);
 }
 
-static NumRange DeserializeNumRange(const string_t &blob) {
-	const size_t expected_size = sizeof(double) * 2 + sizeof(uint8_t);
-	if (blob.GetSize() < expected_size) {
-		throw InvalidInputException("Invalid NUMRANGE blob: expected %zu bytes, got %zu", expected_size,
-		                            blob.GetSize());
+//===--------------------------------------------------------------------===//
+// Legacy BLOB Encoding
+//===--------------------------------------------------------------------===//
+// Before the STRUCT layout, ranges were 9/17-byte BLOBs (lower, upper, flags byte). These decoders back
+// the BLOB -> range migration casts.
+
+// Bit layout of the legacy flags byte: bit 1 = lower_inc, bit 0 = upper_inc
+static constexpr uint8_t LEGACY_LOWER_INC = 0b10;
+static constexpr uint8_t LEGACY_UPPER_INC = 0b01;
+
+template <class RANGE>
+static RANGE DeserializeLegacyRange(const string_t &blob, const char *type_name) {
+	using BOUND_TYPE = decltype(RANGE::lower);
+	const size_t expected_size = sizeof(BOUND_TYPE) * 2 + sizeof(uint8_t);
+	// Anything but the exact size is not a legacy range, e.g. a truncated value or one with trailing garbage
+	if (blob.GetSize() != expected_size) {
+		throw ConversionException("Invalid %s blob: expected %zu bytes, got %zu", type_name, expected_size,
+		                          blob.GetSize());
 	}
-	NumRange range;
+	RANGE range;
 	auto ptr = blob.GetDataUnsafe();
-	memcpy(&range.lower, ptr, sizeof(double));
-	memcpy(&range.upper, ptr + sizeof(double), sizeof(double));
+	memcpy(&range.lower, ptr, sizeof(BOUND_TYPE));
+	memcpy(&range.upper, ptr + sizeof(BOUND_TYPE), sizeof(BOUND_TYPE));
 	uint8_t bounds;
-	memcpy(&bounds, ptr + sizeof(double) * 2, sizeof(uint8_t));
-	range.lower_inc = (bounds & 0b10) != 0;
-	range.upper_inc = (bounds & 0b01) != 0;
+	memcpy(&bounds, ptr + sizeof(BOUND_TYPE) * 2, sizeof(uint8_t));
+	range.lower_inc = (bounds & LEGACY_LOWER_INC) != 0;
+	range.upper_inc = (bounds & LEGACY_UPPER_INC) != 0;
+	range.lower_inf = false;
+	range.upper_inf = false;
 	return range;
 }
 
-static bool IsEmptyNum(const NumRange &range) {
-	if (range.lower > range.upper) {
-		return true;
+//===--------------------------------------------------------------------===//
+// Text Format
+//===--------------------------------------------------------------------===//
+// Range literals are parsed in place on the string_t bytes: the bounds go straight through DuckDB's own
+// numeric TryCast, so loading a column of literals never copies a string or unwinds an exception per row.
+
+enum class RangeParseResult : uint8_t { SUCCESS, MALFORMED, MISSING_COMMA, INVALID_BOUND };
+
+static bool IsEmptyLiteral(const char *data, idx_t size) {
+	static constexpr const char *EMPTY_LITERAL = "empty";
+	if (size != 5) {
+		return false;
 	}
-	if (range.lower == range.upper) {
-		return !(range.lower_inc && range.upper_inc);
+	for (idx_t i = 0; i < size; i++) {
+		if (StringUtil::CharacterToLower(data[i]) != EMPTY_LITERAL[i]) {
+			return false;
+		}
 	}
-	return false;
+	return true;
 }
 
-static string_t ConstructNumRangeValue(Vector &result, double lower, double upper, bool lower_inc, bool upper_inc) {
-	NumRange range = {lower, upper, lower_inc, upper_inc};
-	return SerializeNumRange(range, result);
+template <class T>
+static bool TryCastBound(const string_t &input, T &result) {
+	return TryCast::Operation<string_t, T>(input, result);
 }
 
-static NumRange ParseNumRange(const string &input_str) {
-	const string &s = input_str;
+// TIMESTAMPTZ bounds are read like TIMESTAMP ones, which converts a UTC offset (e.g. +02) when one is present
+static bool TryCastBound(const string_t &input, timestamp_tz_t &result) {
+	timestamp_t timestamp;
+	if (!TryCast::Operation<string_t, timestamp_t>(input, timestamp)) {
+		return false;
+	}
+	result = timestamp_tz_t(timestamp);
+	return true;
+}
 
-	if (StringUtil::CIEquals(s, "empty")) {
-		return {1.0, 0.0, false, false}; // Canonical empty
+//! Parses one bound of a range literal, which may be double-quoted like PostgreSQL renders timestamps
+template <class T>
+static bool TryParseBound(const char *data, idx_t size, T &result) {
+	if (size >= 2 && data[0] == '"' && data[size - 1] == '"') {
+		data++;
+		size -= 2;
 	}
+	return TryCastBound(string_t(data, UnsafeNumericCast<uint32_t>(size)), result);
+}
+
+template <class RANGE>
+static RangeParseResult TryParseRange(const string_t &input, RANGE &range) {
+	using BOUND_TYPE = decltype(RANGE::lower);
+	auto data = input.GetData();
+	auto size = input.GetSize();
 
-	if (s.length() < 3) {
-		throw InvalidInputException("Malformed range literal: \"%s\"", input_str);
+	if (IsEmptyLiteral(data, size)) {
+		range = EmptyRange<BOUND_TYPE>();
+		return RangeParseResult::SUCCESS;
+	}
+	if (size < 3) {
+		return RangeParseResult::MALFORMED;
 	}
 
-	bool lower_inc;
-	if (s.front() == '[') {
-		lower_inc = true;
-	} else if (s.front() == '(') {
-		lower_inc = false;
+	if (data[0] == '[') {
+		range.lower_inc = true;
+	} else if (data[0] == '(') {
+		range.lower_inc = false;
 	} else {
-		throw InvalidInputException("Malformed range literal: \"%s\"", input_str);
+		return RangeParseResult::MALFORMED;
 	}
-
-	bool upper_inc;
-	if (s.back() == ']') {
-		upper_inc = true;
-	} else if (s.back() == ')') {
-		upper_inc = false;
+	if (data[size - 1] == ']') {
+		range.upper_inc = true;
+	} else if (data[size - 1] == ')') {
+		range.upper_inc = false;
 	} else {
-		throw InvalidInputException("Malformed range literal: \"%s\"", input_str);
+		return RangeParseResult::MALFORMED;
+	}
+
+	auto comma = static_cast<const char *>(memchr(data, ',', size));
+	if (!comma) {
+		return RangeParseResult::MISSING_COMMA;
+	}
+	// A missing bound, as in '(,5]' or '[1,)', is infinite
+	auto comma_pos = idx_t(comma - data);
+	auto lower_size = comma_pos - 1;
+	auto upper_size = size - comma_pos - 2;
+	range.lower_inf = lower_size == 0;
+	range.upper_inf = upper_size == 0;
+	if (range.lower_inf) {
+		range.lower = RangeTraits<BOUND_TYPE>::Lowest();
+		range.lower_inc = true;
+	} else if (!TryParseBound(data + 1, lower_size, range.lower)) {
+		return RangeParseResult::INVALID_BOUND;
+	}
+	if (range.upper_inf) {
+		range.upper = RangeTraits<BOUND_TYPE>::Highest();
+		range.upper_inc = true;
+	} else if (!TryParseBound(comma + 1, upper_size, range.upper)) {
+		return RangeParseResult::INVALID_BOUND;
 	}
+	return RangeParseResult::SUCCESS;
+}
+
+static string RangeParseErrorMessage(RangeParseResult status, const string_t &input, const char *bound_kind) {
+	auto input_str = input.GetString();
+	switch (status) {
+	case RangeParseResult::MISSING_COMMA:
+		return StringUtil::Format("Malformed range literal: \"%s\" (missing comma)", input_str);
+	case RangeParseResult::INVALID_BOUND:
+		return StringUtil::Format("Invalid %s in range literal: \"%s\"", bound_kind, input_str);
+	default:
+		return StringUtil::Format("Malformed range literal: \"%s\"", input_str);
+	}
+}
 
-	auto comma_pos = s.find(',');
-	if (comma_pos == string::npos) {
-		throw InvalidInputException("Malformed range literal: \"%s\" (missing comma)", input_str);
+template <class RANGE>
+static RANGE ParseRange(const string_t &input) {
+	RANGE range;
+	auto status = TryParseRange(input, range);
+	if (status != RangeParseResult::SUCCESS) {
+		throw InvalidInputException(
+		    RangeParseErrorMessage(status, input, RangeTraits<decltype(RANGE::lower)>::BoundName()));
 	}
+	return range;
+}
 
-	string lower_str = s.substr(1, comma_pos - 1);
-	string upper_str = s.substr(comma_pos + 1, s.length() - comma_pos - 2);
+//! Parses a dictionary-encoded VARCHAR vector into ranges, see ExecuteParseDictionary
+template <class RANGE>
+static bool ParseRangeDictionary(Vector &source, Vector &result, idx_t count) {
+	return ExecuteParseDictionary<RangeWriter<RANGE>>(
+	    source, result, count, [](const string_t &input, RangeWriter<RANGE> &writer, idx_t i) {
+		    RANGE range;
+		    if (TryParseRange(input, range) != RangeParseResult::SUCCESS) {
+			    return false;
+		    }
+		    writer.Set(i, range);
+		    return true;
+	    });
+}
 
-	double lower, upper;
-	try {
-		lower = std::stod(lower_str);
-		upper = std::stod(upper_str);
-	} catch (...) {
-		throw InvalidInputException("Invalid number in range literal: \"%s\"", input_str);
+static constexpr idx_t RANGE_BOUND_BUFFER_SIZE = 48;
+
+//! Writes the decimal digits of value, zero-padded to at least width digits, returning the number written
+static idx_t FormatDigits(uint64_t value, idx_t width, char *buffer) {
+	char digits[20];
+	idx_t digit_count = 0;
+	do {
+		digits[digit_count++] = char('0' + value % 10);
+		value /= 10;
+	} while (value != 0);
+	idx_t length = 0;
+	while (length + digit_count < width) {
+		buffer[length++] = '0';
 	}
+	while (digit_count > 0) {
+		buffer[length++] = digits[--digit_count];
+	}
+	return length;
+}
 
-	return {lower, upper, lower_inc, upper_inc};
+//! Writes the decimal digits of an integer bound, returning the number of characters written
+static idx_t FormatBound(int64_t value, char *buffer) {
+	idx_t length = 0;
+	if (value < 0) {
+		buffer[length++] = '-';
+	}
+	return length + FormatDigits(value < 0 ? uint64_t(0) - uint64_t(value) : uint64_t(value), 1, buffer + length);
 }
 
-static void NumRangeConstructor4(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &lower_vec = args.data[0];
-	auto &upper_vec = args.data[1];
-	auto &lower_inc_vec = args.data[2];
-	auto &upper_inc_vec = args.data[3];
-	idx_t count = args.size();
+//! Writes the shortest representation that reads back as the same double, through the same locale-independent
+//! formatter as DuckDB's DOUBLE -> VARCHAR cast, e.g. 5.0, 0.1, 1e+20 or inf
+static idx_t FormatBound(double value, char *buffer) {
+	auto length = duckdb_fmt::format_to_n(buffer, RANGE_BOUND_BUFFER_SIZE, "{}", value).size;
+	D_ASSERT(length <= RANGE_BOUND_BUFFER_SIZE);
+	// Integral values keep a fractional part so they still read as DOUBLE, e.g. 5.0
+	if (std::isfinite(value) && !memchr(buffer, '.', length) && !memchr(buffer, 'e', length)) {
+		buffer[length++] = '.';
+		buffer[length++] = '0';
+	}
+	return length;
+}
 
-	UnifiedVectorFormat lower_data, upper_data, lower_inc_data, upper_inc_data;
-	lower_vec.ToUnifiedFormat(count, lower_data);
-	upper_vec.ToUnifiedFormat(count, upper_data);
-	lower_inc_vec.ToUnifiedFormat(count, lower_inc_data);
-	upper_inc_vec.ToUnifiedFormat(count, upper_inc_data);
+static idx_t FormatBound(int32_t value, char *buffer) {
+	return FormatBound(int64_t(value), buffer);
+}
 
-	auto lower_ptr = UnifiedVectorFormat::GetData<double>(lower_data);
-	auto upper_ptr = UnifiedVectorFormat::GetData<double>(upper_data);
-	auto lower_inc_ptr = UnifiedVectorFormat::GetData<bool>(lower_inc_data);
-	auto upper_inc_ptr = UnifiedVectorFormat::GetData<bool>(upper_inc_data);
+//! Writes the text of an infinite DATE or TIMESTAMP bound value
+static idx_t FormatInfinity(bool negative, char *buffer) {
+	idx_t length = 0;
+	if (negative) {
+		buffer[length++] = '-';
+	}
+	memcpy(buffer + length, "infinity", 8);
+	return length + 8;
+}
 
-	for (idx_t i = 0; i < count; i++) {
-		idx_t lower_idx = lower_data.sel ? lower_data.sel->get_index(i) : i;
-		idx_t upper_idx = upper_data.sel ? upper_data.sel->get_index(i) : i;
-		idx_t lower_inc_idx = lower_inc_data.sel ? lower_inc_data.sel->get_index(i) : i;
-		idx_t upper_inc_idx = upper_inc_data.sel ? upper_inc_data.sel->get_index(i) : i;
+//! Writes a date, and the time of a timestamp, like DuckDB's cast to VARCHAR: 2024-01-31, 0044-03-15 (BC) or
+//! 2024-01-31 10:00:00.5 followed by suffix. Text with a space is double-quoted like PostgreSQL does for
+//! timestamps. At most 38 characters are written, well within RANGE_BOUND_BUFFER_SIZE.
+static idx_t FormatDateTime(date_t date, const dtime_t *time, const char *suffix, char *buffer) {
+	int32_t year, month, day;
+	Date::Convert(date, year, month, day);
+	auto before_christ = year <= 0;
+	auto quote = before_christ || time;
+	idx_t length = 0;
+	if (quote) {
+		buffer[length++] = '"';
+	}
+	length += FormatDigits(before_christ ? uint64_t(1 - int64_t(year)) : uint64_t(year), 4, buffer + length);
+	buffer[length++] = '-';
+	length += FormatDigits(uint64_t(month), 2, buffer + length);
+	buffer[length++] = '-';
+	length += FormatDigits(uint64_t(day), 2, buffer + length);
+	if (before_christ) {
+		memcpy(buffer + length, " (BC)", 5);
+		length += 5;
+	}
+	if (time) {
+		int32_t hour, minute, second, micros;
+		Time::Convert(*time, hour, minute, second, micros);
+		buffer[length++] = ' ';
+		length += FormatDigits(uint64_t(hour), 2, buffer + length);
+		buffer[length++] = ':';
+		length += FormatDigits(uint64_t(minute), 2, buffer + length);
+		buffer[length++] = ':';
+		length += FormatDigits(uint64_t(second), 2, buffer + length);
+		// Microseconds are written without their trailing zeros, and not at all when zero
+		if (micros != 0) {
+			buffer[length++] = '.';
+			auto digit_count = FormatDigits(uint64_t(micros), 6, buffer + length);
+			while (buffer[length + digit_count - 1] == '0') {
+				digit_count--;
+			}
+			length += digit_count;
+		}
+	}
+	auto suffix_size = strlen(suffix);
+	memcpy(buffer + length, suffix, suffix_size);
+	length += suffix_size;
+	if (quote) {
+		buffer[length++] = '"';
+	}
+	return length;
+}
+
+static idx_t FormatBound(date_t value, char *buffer) {
+	if (!Date::IsFinite(value)) {
+		return FormatInfinity(value != date_t::infinity(), buffer);
+	}
+	return FormatDateTime(value, nullptr, "", buffer);
+}
+
+static idx_t FormatBound(timestamp_t value, char *buffer) {
+	if (!Timestamp::IsFinite(value)) {
+		return FormatInfinity(value != timestamp_t::infinity(), buffer);
+	}
+	date_t date;
+	dtime_t time;
+	Timestamp::Convert(value, date, time);
+	return FormatDateTime(date, &time, "", buffer);
+}
+
+// TIMESTAMPTZ bounds are rendered in UTC, independent of the TimeZone setting
+static idx_t FormatBound(timestamp_tz_t value, char *buffer) {
+	timestamp_t utc(value.value);
+	if (!Timestamp::IsFinite(utc)) {
+		return FormatInfinity(utc != timestamp_t::infinity(), buffer);
+	}
+	date_t date;
+	dtime_t time;
+	Timestamp::Convert(utc, date, time);
+	return FormatDateTime(date, &time, "+00", buffer);
+}
+
+static constexpr idx_t RANGE_TEXT_BUFFER_SIZE = RANGE_BOUND_BUFFER_SIZE * 2 + 3;
+
+//! Writes the text form of a range into a buffer of RANGE_TEXT_BUFFER_SIZE, returning its length
+template <class RANGE>
+static idx_t FormatRange(const RANGE &range, bool empty, char *buffer) {
+	if (empty) {
+		memcpy(buffer, "empty", 5);
+		return 5;
+	}
+	// Infinite bounds are written as a missing bound, which is always exclusive: '(,5]'
+	idx_t length = 0;
+	buffer[length++] = range.lower_inc && !range.lower_inf ? '[' : '(';
+	if (!range.lower_inf) {
+		length += FormatBound(range.lower, buffer + length);
+	}
+	buffer[length++] = ',';
+	if (!range.upper_inf) {
+		length += FormatBound(range.upper, buffer + length);
+	}
+	buffer[length++] = range.upper_inc && !range.upper_inf ? ']' : ')';
+	D_ASSERT(length <= RANGE_TEXT_BUFFER_SIZE);
+	return length;
+}
+
+//! Renders a range into the string heap of result; short results are inlined into the string_t itself
+template <class RANGE>
+static string_t RenderRange(const RANGE &range, bool empty, Vector &result) {
+	char buffer[RANGE_TEXT_BUFFER_SIZE];
+	auto length = FormatRange(range, empty, buffer);
+	return StringVector::AddString(result, buffer, length);
+}
 
-		if (!lower_data.validity.RowIsValid(lower_idx) || !upper_data.validity.RowIsValid(upper_idx) ||
-		    !lower_inc_data.validity.RowIsValid(lower_inc_idx) || !upper_inc_data.validity.RowIsValid(upper_inc_idx)) {
+//! VARCHAR -> range cast. Under TRY_CAST a malformed literal becomes NULL instead of raising an error.
+template <class RANGE>
+static bool VarcharToRangeCast(Vector &source, Vector &result, idx_t count, CastParameters &parameters) {
+	if (ParseRangeDictionary<RANGE>(source, result, count)) {
+		RecordRangeCast(parameters, count, 0, 0);
+		auto site = RangeCastStatsSite(parameters);
+		if (site) {
+			site->Add(RangeStatsCounter::DICTIONARY_CHUNKS, 1);
+		}
+		return true;
+	}
+	auto bound_kind = RangeTraits<decltype(RANGE::lower)>::BoundName();
+	ValueReader<string_t> source_data(source, count);
+	auto is_constant = source.GetVectorType() == VectorType::CONSTANT_VECTOR;
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	RangeWriter<RANGE> writer(result);
+	bool all_converted = true;
+	idx_t parse_errors = 0;
+	auto row_count = is_constant ? 1 : count;
+	for (idx_t i = 0; i < row_count; i++) {
+		if (!source_data.RowIsValid(i)) {
 			FlatVector::SetNull(result, i, true);
 			continue;
 		}
-
-		auto serialized = ConstructNumRangeValue(result, lower_ptr[lower_idx], upper_ptr[upper_idx],
-		                                         lower_inc_ptr[lower_inc_idx], upper_inc_ptr[upper_inc_idx]);
-		FlatVector::GetData<string_t>(result)[i] = serialized;
+		auto input = source_data.Get(i);
+		RANGE range;
+		auto status = TryParseRange(input, range);
+		if (status != RangeParseResult::SUCCESS) {
+			HandleCastError::AssignError(RangeParseErrorMessage(status, input, bound_kind), parameters);
+			FlatVector::SetNull(result, i, true);
+			all_converted = false;
+			parse_errors++;
+			continue;
+		}
+		writer.Set(i, range);
 	}
+	if (is_constant) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	}
+	RecordRangeCast(parameters, count, parse_errors, 0);
+	return all_converted;
 }
 
-static void NumRangeConstructor(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &lower_vec = args.data[0];
-	auto &upper_vec = args.data[1];
-	auto &bounds_vec = args.data[2];
+//===--------------------------------------------------------------------===//
+// Range Functions
+//===--------------------------------------------------------------------===//
+// Constructors, casts, containment and accessors, instantiated for every range subtype
 
-	TernaryExecutor::Execute<double, double, string_t, string_t>(
-	    lower_vec, upper_vec, bounds_vec, result, args.size(), [&](double lower, double upper, string_t bounds_blob) {
-		    string bounds_str = bounds_blob.GetString();
-		    bool lower_inc = true;
-		    bool upper_inc = false;
-
-		    if (!bounds_str.empty()) {
-			    if (bounds_str == "[)") {
-				    lower_inc = true;
-				    upper_inc = false;
-			    } else if (bounds_str == "[]") {
-				    lower_inc = true;
-				    upper_inc = true;
-			    } else if (bounds_str == "(]") {
-				    lower_inc = false;
-				    upper_inc = true;
-			    } else if (bounds_str == "()") {
-				    lower_inc = false;
-				    upper_inc = false;
-			    } else {
-				    throw InvalidInputException("Invalid bounds: " + bounds_str);
-			    }
-		    }
-		    return ConstructNumRangeValue(result, lower, upper, lower_inc, upper_inc);
-	    });
+template <class T>
+static inline bool IsEmpty(const Range<T> &range) {
+	// If lower == upper, it's empty unless both bounds are inclusive []
+	return range.lower > range.upper || (range.lower == range.upper && !(range.lower_inc && range.upper_inc));
 }
 
-static bool NumRangeToVarchar(Vector &source, Vector &result, idx_t count, CastParameters &parameters) {
-	UnifiedVectorFormat source_data;
-	source.ToUnifiedFormat(count, source_data);
-	auto source_ptr = UnifiedVectorFormat::GetData<string_t>(source_data);
+// 4-arg constructor: range(lower, upper, lower_inc BOOLEAN, upper_inc BOOLEAN)
+template <class RANGE>
+static void RangeConstructor4(DataChunk &args, ExpressionState &state, Vector &result) {
+	using BOUND_TYPE = decltype(RANGE::lower);
+	idx_t count = args.size();
+	ValueReader<BOUND_TYPE> lower_data(args.data[0], count);
+	ValueReader<BOUND_TYPE> upper_data(args.data[1], count);
+	ValueReader<bool> lower_inc_data(args.data[2], count);
+	ValueReader<bool> upper_inc_data(args.data[3], count);
 
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	RangeWriter<RANGE> writer(result);
 	for (idx_t i = 0; i < count; i++) {
-		auto idx = source_data.sel->get_index(i);
-		if (!source_data.validity.RowIsValid(idx)) {
+		if (!lower_data.RowIsValid(i) || !upper_data.RowIsValid(i) || !lower_inc_data.RowIsValid(i) ||
+		    !upper_inc_data.RowIsValid(i)) {
 			FlatVector::SetNull(result, i, true);
 			continue;
 		}
+		writer.Set(i, RANGE {lower_data.Get(i), upper_data.Get(i), lower_inc_data.Get(i), upper_inc_data.Get(i)});
+	}
+}
 
-		auto range = DeserializeNumRange(source_ptr[idx]);
-		string str;
-		if (IsEmptyNum(range)) {
-			str = "empty";
-		} else {
-			str = (range.lower_inc ? "[" : "(") + std::to_string(range.lower) + "," + std::to_string(range.upper) +
-			      (range.upper_inc ? "]" : ")");
-		}
-		FlatVector::GetData<string_t>(result)[i] = StringVector::AddString(result, str);
+//! Decodes a bounds string such as '[)' from its raw bytes; an empty string means the default '[)'
+static bool TryParseBounds(const string_t &bounds, bool &lower_inc, bool &upper_inc) {
+	auto size = bounds.GetSize();
+	if (size == 0) {
+		lower_inc = true;
+		upper_inc = false;
+		return true;
+	}
+	if (size != 2) {
+		return false;
+	}
+	auto data = bounds.GetData();
+	if (data[0] == '[') {
+		lower_inc = true;
+	} else if (data[0] == '(') {
+		lower_inc = false;
+	} else {
+		return false;
+	}
+	if (data[1] == ']') {
+		upper_inc = true;
+	} else if (data[1] == ')') {
+		upper_inc = false;
+	} else {
+		return false;
 	}
 	return true;
 }
 
-static bool VarcharToNumRangeCast(Vector &source, Vector &result, idx_t count, CastParameters &parameters) {
-	UnifiedVectorFormat source_data;
-	source.ToUnifiedFormat(count, source_data);
-	auto source_ptr = UnifiedVectorFormat::GetData<string_t>(source_data);
+static void ParseBoundsString(const string_t &bounds, bool &lower_inc, bool &upper_inc) {
+	if (!TryParseBounds(bounds, lower_inc, upper_inc)) {
+		throw InvalidInputException("Invalid bounds: " + bounds.GetString());
+	}
+}
+
+//! The bounds argument of the 3-argument constructors, resolved once at bind time when it is a constant
+struct RangeBoundsBindData : public FunctionData {
+	RangeBoundsBindData() : is_constant(false), lower_inc(true), upper_inc(false) {
+	}
+	RangeBoundsBindData(bool lower_inc, bool upper_inc)
+	    : is_constant(true), lower_inc(lower_inc), upper_inc(upper_inc) {
+	}
+
+	bool is_constant;
+	bool lower_inc;
+	bool upper_inc;
+
+	unique_ptr<FunctionData> Copy() const override {
+		return make_uniq<RangeBoundsBindData>(*this);
+	}
+	bool Equals(const FunctionData &other_p) const override {
+		auto &other = other_p.Cast<RangeBoundsBindData>();
+		return is_constant == other.is_constant && lower_inc == other.lower_inc && upper_inc == other.upper_inc;
+	}
+};
+
+static unique_ptr<FunctionData> BindRangeBounds(ClientContext &context, ScalarFunction &bound_function,
+                                                vector<unique_ptr<Expression>> &arguments) {
+	auto &bounds = *arguments[2];
+	if (!bounds.IsFoldable()) {
+		return make_uniq<RangeBoundsBindData>();
+	}
+	auto value = ExpressionExecutor::EvaluateScalar(context, bounds);
+	if (value.IsNull()) {
+		// Every row is NULL; leave that to the regular execution path
+		return make_uniq<RangeBoundsBindData>();
+	}
+	auto bounds_str = value.DefaultCastAs(LogicalType::VARCHAR).ToString();
+	bool lower_inc, upper_inc;
+	string_t bounds_data(bounds_str.c_str(), UnsafeNumericCast<uint32_t>(bounds_str.size()));
+	ParseBoundsString(bounds_data, lower_inc, upper_inc);
+	return make_uniq<RangeBoundsBindData>(lower_inc, upper_inc);
+}
 
+//! range(lower, upper, bounds): with constant bounds this is a plain two-column copy into the struct children
+template <class RANGE>
+static void RangeConstructor3(DataChunk &args, ExpressionState &state, Vector &result) {
+	using BOUND_TYPE = decltype(RANGE::lower);
+	auto &lower_vec = args.data[0];
+	auto &upper_vec = args.data[1];
+	auto &bounds_vec = args.data[2];
+	idx_t count = args.size();
+
+	auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+	if (func_expr.bind_info && func_expr.bind_info->Cast<RangeBoundsBindData>().is_constant) {
+		auto &bind_data = func_expr.bind_info->Cast<RangeBoundsBindData>();
+		auto lower_inc = bind_data.lower_inc;
+		auto upper_inc = bind_data.upper_inc;
+		ExecuteRangeBinary<ValueReader<BOUND_TYPE>, ValueReader<BOUND_TYPE>, RangeWriter<RANGE>>(
+		    lower_vec, upper_vec, result, count,
+		    [&](BOUND_TYPE lower, BOUND_TYPE upper) { return RANGE {lower, upper, lower_inc, upper_inc}; });
+		return;
+	}
+
+	ValueReader<BOUND_TYPE> lower_data(lower_vec, count);
+	ValueReader<BOUND_TYPE> upper_data(upper_vec, count);
+	ValueReader<string_t> bounds_data(bounds_vec, count);
+
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	RangeWriter<RANGE> writer(result);
 	for (idx_t i = 0; i < count; i++) {
-		auto idx = source_data.sel->get_index(i);
-		if (!source_data.validity.RowIsValid(idx)) {
+		if (!lower_data.RowIsValid(i) || !upper_data.RowIsValid(i) || !bounds_data.RowIsValid(i)) {
 			FlatVector::SetNull(result, i, true);
 			continue;
 		}
+		RANGE range {lower_data.Get(i), upper_data.Get(i), true, false};
+		ParseBoundsString(bounds_data.Get(i), range.lower_inc, range.upper_inc);
+		writer.Set(i, range);
+	}
+}
+
+// 2-arg constructor: range(lower, upper) with default bounds '[)'
+template <class RANGE>
+static void RangeConstructor2(DataChunk &args, ExpressionState &state, Vector &result) {
+	using BOUND_TYPE = decltype(RANGE::lower);
+	ExecuteRangeBinary<ValueReader<BOUND_TYPE>, ValueReader<BOUND_TYPE>, RangeWriter<RANGE>>(
+	    args.data[0], args.data[1], result, args.size(),
+	    [&](BOUND_TYPE lower, BOUND_TYPE upper) { return RANGE {lower, upper, true, false}; });
+}
 
-		NumRange range = ParseNumRange(source_ptr[idx].GetString());
-		auto serialized = SerializeNumRange(range, result);
-		FlatVector::GetData<string_t>(result)[i] = serialized;
+// 1-arg constructor: range(varchar)
+template <class RANGE>
+static void RangeConstructor1(DataChunk &args, ExpressionState &state, Vector &result) {
+	if (ParseRangeDictionary<RANGE>(args.data[0], result, args.size())) {
+		return;
 	}
-	return true;
+	ExecuteRangeUnary<ValueReader<string_t>, RangeWriter<RANGE>>(
+	    args.data[0], result, args.size(), [&](string_t input) { return ParseRange<RANGE>(input); });
 }
 
-static void NumRangeConstructor1(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &input_vec = args.data[0];
-	UnaryExecutor::Execute<string_t, string_t>(input_vec, result, args.size(), [&](string_t input) {
-		NumRange range = ParseNumRange(input.GetString());
-		return SerializeNumRange(range, result);
+template <class RANGE>
+static bool RangeToVarcharCast(Vector &source, Vector &result, idx_t count, CastParameters &parameters) {
+	uint64_t text_bytes = 0;
+	ExecuteRangeUnary<RangeReader<RANGE>, ValueWriter<string_t>>(source, result, count, [&](const RANGE &range) {
+		auto text = RenderRange(range, IsEmpty(range), result);
+		text_bytes += text.GetSize();
+		return text;
 	});
+	RecordRangeCast(parameters, count, 0, text_bytes);
+	return true;
+}
+
+template <class RANGE>
+static bool BlobToRangeCast(Vector &source, Vector &result, idx_t count, CastParameters &parameters) {
+	auto type_name = RangeTraits<decltype(RANGE::lower)>::TypeName();
+	ExecuteRangeUnary<ValueReader<string_t>, RangeWriter<RANGE>>(
+	    source, result, count, [&](string_t blob) { return DeserializeLegacyRange<RANGE>(blob, type_name); });
+	RecordRangeCast(parameters, count, 0, 0);
+	return true;
+}
+
+//! Whether the kind codes and bounds of a stored range form a valid range: a finite side needs a non-NULL bound,
+//! and the empty range has both kinds at RANGE_EMPTY_KIND
+static inline bool IsValidRangeEncoding(uint8_t lower_kind, uint8_t upper_kind, bool lower_valid, bool upper_valid) {
+	if (lower_kind > RANGE_LOWER_EXCLUSIVE || upper_kind > RANGE_UPPER_INFINITE) {
+		return false;
+	}
+	if (upper_kind == RANGE_EMPTY_KIND) {
+		return lower_kind == RANGE_EMPTY_KIND;
+	}
+	return (lower_kind == RANGE_LOWER_INFINITE || lower_valid) && (upper_kind == RANGE_UPPER_INFINITE || upper_valid);
+}
+
+//! Storage STRUCT -> range cast, for range columns read back from Parquet or Arrow. The children are validated
+//! and the ranges re-canonicalized, as the data may have been written by another tool. Under TRY_CAST an invalid
+//! range becomes NULL instead of raising an error.
+template <class RANGE>
+static bool StructToRangeCast(Vector &source, Vector &result, idx_t count, CastParameters &parameters) {
+	auto type_name = RangeTraits<decltype(RANGE::lower)>::TypeName();
+	RangeReader<RANGE> source_data(source, count);
+	auto is_constant = source.GetVectorType() == VectorType::CONSTANT_VECTOR;
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	RangeWriter<RANGE> writer(result);
+	bool all_converted = true;
+	idx_t parse_errors = 0;
+	auto row_count = is_constant ? 1 : count;
+	for (idx_t i = 0; i < row_count; i++) {
+		if (!source_data.RowIsValid(i)) {
+			FlatVector::SetNull(result, i, true);
+			continue;
+		}
+		auto lower_kind_idx = source_data.lower_kind_format.sel->get_index(i);
+		auto upper_kind_idx = source_data.upper_kind_format.sel->get_index(i);
+		auto valid = source_data.lower_kind_format.validity.RowIsValid(lower_kind_idx) &&
+		             source_data.upper_kind_format.validity.RowIsValid(upper_kind_idx) &&
+		             IsValidRangeEncoding(
+		                 source_data.lower_kind_data[lower_kind_idx], source_data.upper_kind_data[upper_kind_idx],
+		                 source_data.lower_format.validity.RowIsValid(source_data.lower_format.sel->get_index(i)),
+		                 source_data.upper_format.validity.RowIsValid(source_data.upper_format.sel->get_index(i)));
+		if (!valid) {
+			HandleCastError::AssignError(StringUtil::Format("Invalid %s encoding in STRUCT", type_name), parameters);
+			FlatVector::SetNull(result, i, true);
+			all_converted = false;
+			parse_errors++;
+			continue;
+		}
+		writer.Set(i, source_data.Get(i));
+	}
+	if (is_constant) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	}
+	RecordRangeCast(parameters, count, parse_errors, 0);
+	return all_converted;
 }
 
-static void NumRangeOverlaps(DataChunk &args, ExpressionState &state, Vector &result) {
+template <class RANGE>
+static void RangeOverlaps(DataChunk &args, ExpressionState &state, Vector &result) {
 	auto &r1_vec = args.data[0];
 	auto &r2_vec = args.data[1];
 
-	BinaryExecutor::Execute<string_t, string_t, bool>(
-	    r1_vec, r2_vec, result, args.size(), [&](string_t r1_blob, string_t r2_blob) {
-		    auto r1 = DeserializeNumRange(r1_blob);
-		    auto r2 = DeserializeNumRange(r2_blob);
-
-		    if (IsEmptyNum(r1) || IsEmptyNum(r2))
+	ExecuteRangeBinary<RangeReader<RANGE>, RangeReader<RANGE>, ValueWriter<bool>>(
+	    r1_vec, r2_vec, result, args.size(), [&](const RANGE &r1, const RANGE &r2) {
+		    if (IsEmpty(r1) || IsEmpty(r2))
 			    return false;
 
+		    // Overlap logic: not (r1 entirely left of r2 or r1 entirely right of r2)
+		    // r1 left of r2: r1.upper < r2.lower OR (r1.upper == r2.lower AND (!r1.upper_inc OR
+		    // !r2.lower_inc))
+
 		    bool r1_left_of_r2 = (r1.upper < r2.lower) || (r1.upper == r2.lower && (!r1.upper_inc || !r2.lower_inc));
 		    bool r2_left_of_r1 = (r2.upper < r1.lower) || (r2.upper == r1.lower && (!r2.upper_inc || !r1.lower_inc));
 
@@ -731,252 +1604,2117 @@ static void NumRangeOverlaps(DataChunk &args, ExpressionState &state, Vector &re
 	    });
 }
 
-static void NumRangeContains(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &range_vec = args.data[0];
-	auto &value_vec = args.data[1];
+// Inline containment check for the hot path (JOIN operations). The comparisons are combined with bitwise
+// operators so the check compiles without branches. An empty range contains nothing: its canonical encoding
+// has both bounds at the lowest value and exclusive, so no value is below its upper bound. An infinite side
+// accepts every value without looking at the bound, except NaN, which is in no range.
+template <class T>
+static inline bool IsRangeValue(T value) {
+	return true;
+}
+
+static inline bool IsRangeValue(double value) {
+	return value == value;
+}
 
-	BinaryExecutor::Execute<string_t, double, bool>(
-	    range_vec, value_vec, result, args.size(), [&](string_t range_blob, double value) {
-		    auto range = DeserializeNumRange(range_blob);
+template <class T>
+static inline bool ContainsValue(const Range<T> &range, T value) {
+	const bool above_lower = range.lower_inf | (range.lower < value) | ((range.lower == value) & range.lower_inc);
+	const bool below_upper = range.upper_inf | (value < range.upper) | ((value == range.upper) & range.upper_inc);
+	return above_lower & below_upper & IsRangeValue(value);
+}
 
-		    if (IsEmptyNum(range))
-			    return false;
+// Containment kernel for a constant range probed with a flat column, e.g. `numrange(10, 20) @> col`: the
+// inclusivity flags pick one of four comparison loops up front, leaving a branch-free loop the compiler vectorizes
+template <class T, bool LOWER_INC, bool UPPER_INC>
+static void ContainsConstantRangeLoop(const Range<T> &range, const T *values, bool *result_data, idx_t count) {
+	for (idx_t i = 0; i < count; i++) {
+		auto value = values[i];
+		bool above_lower = LOWER_INC ? value >= range.lower : value > range.lower;
+		bool below_upper = UPPER_INC ? value <= range.upper : value < range.upper;
+		result_data[i] = above_lower & below_upper;
+	}
+}
 
-		    bool above_lower = (value > range.lower) || (value == range.lower && range.lower_inc);
-		    bool below_upper = (value < range.upper) || (value == range.upper && range.upper_inc);
+template <class T>
+static void ContainsConstantRange(const Range<T> &range, const T *values, bool *result_data, idx_t count) {
+	if (range.lower_inc && range.upper_inc) {
+		ContainsConstantRangeLoop<T, true, true>(range, values, result_data, count);
+	} else if (range.lower_inc) {
+		ContainsConstantRangeLoop<T, true, false>(range, values, result_data, count);
+	} else if (range.upper_inc) {
+		ContainsConstantRangeLoop<T, false, true>(range, values, result_data, count);
+	} else {
+		ContainsConstantRangeLoop<T, false, false>(range, values, result_data, count);
+	}
+}
 
-		    return above_lower && below_upper;
-	    });
+// INT4RANGE specialization: the inclusivity flags fold into an inclusive [lo, hi] window (in 64 bits, so it
+// cannot overflow), which leaves a single unsigned compare per row that vectorizes like a native BETWEEN
+static void ContainsConstantRange(const Int4Range &range, const int32_t *values, bool *result_data, idx_t count) {
+	const int64_t lo = int64_t(range.lower) + (range.lower_inc ? 0 : 1);
+	const int64_t hi = int64_t(range.upper) - (range.upper_inc ? 0 : 1);
+	if (lo > hi) {
+		memset(result_data, 0, count * sizeof(bool));
+		return;
+	}
+	const uint64_t width = uint64_t(hi - lo);
+	for (idx_t i = 0; i < count; i++) {
+		result_data[i] = uint64_t(int64_t(values[i]) - lo) <= width;
+	}
+}
+
+//! Shared fast path for `constant_range @> flat_values`. Returns false if the inputs do not have that shape.
+template <class RANGE>
+static bool TryContainsConstantRange(Vector &range_vec, Vector &value_vec, Vector &result, idx_t count) {
+	using BOUND_TYPE = decltype(RANGE::lower);
+	if (range_vec.GetVectorType() != VectorType::CONSTANT_VECTOR ||
+	    value_vec.GetVectorType() != VectorType::FLAT_VECTOR) {
+		return false;
+	}
+	RangeReader<RANGE> range_data(range_vec, 1);
+	if (!range_data.RowIsValid(0)) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+		ConstantVector::SetNull(result, true);
+		return true;
+	}
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	ContainsConstantRange(range_data.Get(0), FlatVector::GetData<BOUND_TYPE>(value_vec),
+	                      FlatVector::GetData<bool>(result), count);
+	FlatVector::SetValidity(result, FlatVector::Validity(value_vec));
+	return true;
 }
 
-static void NumRangeContainedBy(DataChunk &args, ExpressionState &state, Vector &result) {
+template <class RANGE>
+static void RangeContains(DataChunk &args, ExpressionState &state, Vector &result) {
+	using BOUND_TYPE = decltype(RANGE::lower);
+	auto &range_vec = args.data[0];
+	auto &value_vec = args.data[1];
+
+	if (TryContainsConstantRange<RANGE>(range_vec, value_vec, result, args.size())) {
+		return;
+	}
+	ExecuteRangeBinary<RangeReader<RANGE>, ValueReader<BOUND_TYPE>, ValueWriter<bool>>(
+	    range_vec, value_vec, result, args.size(),
+	    [&](const RANGE &range, BOUND_TYPE value) { return ContainsValue(range, value); });
+}
+
+template <class RANGE>
+static void RangeContainedBy(DataChunk &args, ExpressionState &state, Vector &result) {
+	using BOUND_TYPE = decltype(RANGE::lower);
 	auto &value_vec = args.data[0];
 	auto &range_vec = args.data[1];
 
-	BinaryExecutor::Execute<double, string_t, bool>(
-	    value_vec, range_vec, result, args.size(), [&](double value, string_t range_blob) {
-		    auto range = DeserializeNumRange(range_blob);
+	if (TryContainsConstantRange<RANGE>(range_vec, value_vec, result, args.size())) {
+		return;
+	}
+	ExecuteRangeBinary<ValueReader<BOUND_TYPE>, RangeReader<RANGE>, ValueWriter<bool>>(
+	    value_vec, range_vec, result, args.size(),
+	    [&](BOUND_TYPE value, const RANGE &range) { return ContainsValue(range, value); });
+}
 
-		    if (IsEmptyNum(range))
-			    return false;
+// Accessors: lower(RANGE) / upper(RANGE) -> bound type, NULL for an infinite bound or the empty range like in
+// PostgreSQL, rather than their stored sentinel values. Unless the chunk has such a row, the result is a zero-copy
+// reference to the child vector, like struct_extract.
+template <class RANGE, bool UPPER>
+static void RangeBound(DataChunk &args, ExpressionState &state, Vector &result) {
+	using BOUND_TYPE = decltype(RANGE::lower);
+	auto &input = args.data[0];
+	auto count = args.size();
+	RangeReader<RANGE> ranges(input, count);
+	auto is_constant = input.GetVectorType() == VectorType::CONSTANT_VECTOR;
+	auto row_count = is_constant ? 1 : count;
+	auto is_unbounded = [&](idx_t row) {
+		auto range = ranges.Get(row);
+		return (UPPER ? range.upper_inf : range.lower_inf) || IsEmpty(range);
+	};
+	bool has_unbounded = false;
+	for (idx_t i = 0; i < row_count && !has_unbounded; i++) {
+		has_unbounded = ranges.RowIsValid(i) && is_unbounded(i);
+	}
+	if (!has_unbounded) {
+		result.Reference(*StructVector::GetEntries(input)[UPPER ? RANGE_UPPER_INDEX : RANGE_LOWER_INDEX]);
+		return;
+	}
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<BOUND_TYPE>(result);
+	for (idx_t i = 0; i < row_count; i++) {
+		if (!ranges.RowIsValid(i) || is_unbounded(i)) {
+			FlatVector::SetNull(result, i, true);
+			continue;
+		}
+		auto range = ranges.Get(i);
+		result_data[i] = UPPER ? range.upper : range.lower;
+	}
+	if (is_constant) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	}
+}
+
+// Accessor: isempty(RANGE) -> BOOLEAN
+template <class RANGE>
+static void RangeIsEmpty(DataChunk &args, ExpressionState &state, Vector &result) {
+	ExecuteRangeUnary<RangeReader<RANGE>, ValueWriter<bool>>(args.data[0], result, args.size(),
+	                                                         [&](const RANGE &range) { return IsEmpty(range); });
+}
+
+// Accessor: lower_inc(RANGE) -> BOOLEAN
+static void RangeLowerInc(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &kind_vec = *StructVector::GetEntries(args.data[0])[RANGE_LOWER_KIND_INDEX];
+	UnaryExecutor::Execute<uint8_t, bool>(kind_vec, result, args.size(),
+	                                      [&](uint8_t kind) { return kind == RANGE_LOWER_INCLUSIVE; });
+}
 
-		    bool above_lower = (value > range.lower) || (value == range.lower && range.lower_inc);
-		    bool below_upper = (value < range.upper) || (value == range.upper && range.upper_inc);
+// Accessor: upper_inc(RANGE) -> BOOLEAN
+static void RangeUpperInc(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &kind_vec = *StructVector::GetEntries(args.data[0])[RANGE_UPPER_KIND_INDEX];
+	UnaryExecutor::Execute<uint8_t, bool>(kind_vec, result, args.size(),
+	                                      [&](uint8_t kind) { return kind == RANGE_UPPER_INCLUSIVE; });
+}
 
-		    return above_lower && below_upper;
+// Accessor: lower_inf(RANGE) -> BOOLEAN
+// A lower kind of 0 is also the empty range, which is told apart by its upper kind
+static void RangeLowerInf(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &entries = StructVector::GetEntries(args.data[0]);
+	BinaryExecutor::Execute<uint8_t, uint8_t, bool>(
+	    *entries[RANGE_LOWER_KIND_INDEX], *entries[RANGE_UPPER_KIND_INDEX], result, args.size(),
+	    [&](uint8_t lower_kind, uint8_t upper_kind) {
+		    return lower_kind == RANGE_LOWER_INFINITE && upper_kind != RANGE_EMPTY_KIND;
 	    });
 }
 
-static void NumRangeLower(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &range_vec = args.data[0];
-	UnaryExecutor::Execute<string_t, double>(range_vec, result, args.size(), [&](string_t range_blob) {
-		auto range = DeserializeNumRange(range_blob);
-		return range.lower;
-	});
+// Accessor: upper_inf(RANGE) -> BOOLEAN
+static void RangeUpperInf(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &kind_vec = *StructVector::GetEntries(args.data[0])[RANGE_UPPER_KIND_INDEX];
+	UnaryExecutor::Execute<uint8_t, bool>(kind_vec, result, args.size(),
+	                                      [&](uint8_t kind) { return kind == RANGE_UPPER_INFINITE; });
 }
 
-static void NumRangeUpper(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &range_vec = args.data[0];
-	UnaryExecutor::Execute<string_t, double>(range_vec, result, args.size(), [&](string_t range_blob) {
-		auto range = DeserializeNumRange(range_blob);
-		return range.upper;
-	});
+// range_hash(RANGE) -> UBIGINT: ranges are stored canonically, so equal ranges have equal bound and kind
+// children, and DuckDB's own struct hash is a hash consistent with range equality. GROUP BY, DISTINCT and
+// hash joins on ranges already use it; range_hash exposes the same value, e.g. for partitioning.
+static void RangeHash(DataChunk &args, ExpressionState &state, Vector &result) {
+	VectorOperations::Hash(args.data[0], result, args.size());
 }
 
-static void NumRangeIsEmpty(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &range_vec = args.data[0];
-	UnaryExecutor::Execute<string_t, bool>(range_vec, result, args.size(), [&](string_t range_blob) {
-		auto range = DeserializeNumRange(range_blob);
-		return IsEmptyNum(range);
-	});
+// Statistics of the constructors: the bound children take the min/max of the bound arguments. Canonicalization
+// moves a discrete bound up by one when it is exclusive (lower) or inclusive (upper), and an empty range is
+// stored at the lowest value, so whichever side of the statistics that could break is dropped instead.
+static BaseStatistics RangeBoundStatistics(const BaseStatistics &input, bool keep_min, bool keep_max) {
+	auto result = NumericStats::CreateUnknown(input.GetType());
+	if (keep_min) {
+		NumericStats::SetMin(result, NumericStats::Min(input));
+	}
+	if (keep_max) {
+		NumericStats::SetMax(result, NumericStats::Max(input));
+	}
+	return result;
 }
 
-static void NumRangeLowerInc(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &range_vec = args.data[0];
-	UnaryExecutor::Execute<string_t, bool>(range_vec, result, args.size(), [&](string_t range_blob) {
-		auto range = DeserializeNumRange(range_blob);
-		return range.lower_inc;
-	});
+template <class RANGE>
+static unique_ptr<BaseStatistics> RangeConstructorStatistics(vector<BaseStatistics> &child_stats,
+                                                             bool lower_may_be_exclusive, bool upper_may_be_inclusive,
+                                                             bool upper_may_be_exclusive) {
+	using BOUND_TYPE = decltype(RANGE::lower);
+	auto &lower = child_stats[0];
+	auto &upper = child_stats[1];
+	if (!NumericStats::HasMinMax(lower) || !NumericStats::HasMinMax(upper)) {
+		return nullptr;
+	}
+	auto lower_shifts = RangeTraits<BOUND_TYPE>::DISCRETE && lower_may_be_exclusive;
+	auto upper_shifts = RangeTraits<BOUND_TYPE>::DISCRETE && upper_may_be_inclusive;
+	// Every range is non-empty if all lower bounds are below all upper bounds, except for discrete '()' ranges
+	// such as (1,2)
+	auto may_be_empty =
+	    !(NumericStats::Max(lower) < NumericStats::Min(upper)) || (lower_shifts && upper_may_be_exclusive);
+	auto result = StructStats::CreateUnknown(GetRangeType<BOUND_TYPE>());
+	StructStats::SetChildStats(result, RANGE_LOWER_INDEX, RangeBoundStatistics(lower, !may_be_empty, !lower_shifts));
+	StructStats::SetChildStats(result, RANGE_UPPER_INDEX, RangeBoundStatistics(upper, !may_be_empty, !upper_shifts));
+	return result.ToUnique();
 }
 
-static void NumRangeUpperInc(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &range_vec = args.data[0];
-	UnaryExecutor::Execute<string_t, bool>(range_vec, result, args.size(), [&](string_t range_blob) {
-		auto range = DeserializeNumRange(range_blob);
-		return range.upper_inc;
-	});
+template <class RANGE>
+static unique_ptr<BaseStatistics> RangeConstructor2Statistics(ClientContext &context, FunctionStatisticsInput &input) {
+	return RangeConstructorStatistics<RANGE>(input.child_stats, false, false, true);
 }
 
-static void NumRangeConstructor2(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &lower_vec = args.data[0];
-	auto &upper_vec = args.data[1];
+template <class RANGE>
+static unique_ptr<BaseStatistics> RangeConstructor3Statistics(ClientContext &context, FunctionStatisticsInput &input) {
+	if (!input.bind_data || !input.bind_data->Cast<RangeBoundsBindData>().is_constant) {
+		return RangeConstructorStatistics<RANGE>(input.child_stats, true, true, true);
+	}
+	auto &bind_data = input.bind_data->Cast<RangeBoundsBindData>();
+	return RangeConstructorStatistics<RANGE>(input.child_stats, !bind_data.lower_inc, bind_data.upper_inc,
+	                                         !bind_data.upper_inc);
+}
 
-	BinaryExecutor::Execute<double, double, string_t>(
-	    lower_vec, upper_vec, result, args.size(),
-	    [&](double lower, double upper) { return ConstructNumRangeValue(result, lower, upper, true, false); });
+template <class RANGE>
+static unique_ptr<BaseStatistics> RangeConstructor4Statistics(ClientContext &context, FunctionStatisticsInput &input) {
+	return RangeConstructorStatistics<RANGE>(input.child_stats, true, true, true);
 }
 
-static void LoadInternal(ExtensionLoader &loader) {
-	loader.RegisterType("INT4RANGE", GetInt4RangeType());
+// Statistics of lower(RANGE) / upper(RANGE): those of the bound child, which the scan keeps per row group. An
+// infinite bound and the empty range read as NULL.
+template <bool UPPER>
+static unique_ptr<BaseStatistics> RangeBoundAccessorStatistics(ClientContext &context,
+                                                               FunctionStatisticsInput &input) {
+	auto &range_stats = input.child_stats[0];
+	auto result = StructStats::GetChildStats(range_stats, UPPER ? RANGE_UPPER_INDEX : RANGE_LOWER_INDEX).Copy();
+	result.Set(StatsInfo::CAN_HAVE_NULL_VALUES);
+	return result.ToUnique();
+}
 
-	// Constructor: int4range(lower INT, upper INT, bounds VARCHAR) -> INT4RANGE
-	ScalarFunction int4range_fun("int4range", {LogicalType::INTEGER, LogicalType::INTEGER, LogicalType::VARCHAR},
-	                             GetInt4RangeType(), Int4RangeConstructor);
-	loader.RegisterFunction(int4range_fun);
+//! Registers range type RANGE with its constructors, text casts, containment operators and accessors
+template <class RANGE>
+static void RegisterRangeType(ExtensionLoader &loader) {
+	using BOUND_TYPE = decltype(RANGE::lower);
+	using TRAITS = RangeTraits<BOUND_TYPE>;
+	auto range_type = GetRangeType<BOUND_TYPE>();
+	auto bound_type = TRAITS::BoundType();
+	auto name = StringUtil::Lower(TRAITS::TypeName());
+	loader.RegisterType(TRAITS::TypeName(), range_type);
+
+	// Constructor (shown for INT4RANGE): int4range(lower, upper, bounds VARCHAR)
+	ScalarFunction range_fun3(name, {bound_type, bound_type, LogicalType::VARCHAR}, range_type,
+	                          RangeConstructor3<RANGE>, BindRangeBounds);
+	range_fun3.statistics = RangeConstructor3Statistics<RANGE>;
+	RegisterRangeFunction(loader, range_fun3);
+
+	// Constructor: int4range(lower, upper) (default bounds '[)')
+	ScalarFunction range_fun2(name, {bound_type, bound_type}, range_type, RangeConstructor2<RANGE>);
+	range_fun2.statistics = RangeConstructor2Statistics<RANGE>;
+	RegisterRangeFunction(loader, range_fun2);
+
+	// Constructor: int4range(varchar)
+	ScalarFunction range_fun1(name, {LogicalType::VARCHAR}, range_type, RangeConstructor1<RANGE>);
+	RegisterRangeFunction(loader, range_fun1);
+
+	// Constructor: int4range(lower, upper, lower_inc BOOLEAN, upper_inc BOOLEAN)
+	ScalarFunction range_fun4(name, {bound_type, bound_type, LogicalType::BOOLEAN, LogicalType::BOOLEAN}, range_type,
+	                          RangeConstructor4<RANGE>);
+	range_fun4.statistics = RangeConstructor4Statistics<RANGE>;
+	RegisterRangeFunction(loader, range_fun4);
+
+	// Casts: range <-> VARCHAR
+	auto type_name = string(TRAITS::TypeName());
+	loader.RegisterCastFunction(range_type, LogicalType::VARCHAR,
+	                            RangeCastInfo(RangeToVarcharCast<RANGE>, type_name + " -> VARCHAR"), 1);
+	loader.RegisterCastFunction(LogicalType::VARCHAR, range_type,
+	                            RangeCastInfo(VarcharToRangeCast<RANGE>, "VARCHAR -> " + type_name), 1);
+
+	// Cast: storage STRUCT -> range, so columns read from Parquet or Arrow bind to the range functions directly.
+	// The other direction is DuckDB's own struct cast, which is free as the layouts are identical.
+	loader.RegisterCastFunction(MakeRangeStorageType(bound_type), range_type,
+	                            RangeCastInfo(StructToRangeCast<RANGE>, "STRUCT -> " + type_name), 1);
+
+	// Operator: range_overlaps(range, range) -> BOOLEAN
+	ScalarFunction overlaps_fun("range_overlaps", {range_type, range_type}, LogicalType::BOOLEAN,
+	                            RangeOverlaps<RANGE>);
+	RegisterRangeFunction(loader, overlaps_fun);
+
+	// Operator: range_contains(range, value) -> BOOLEAN
+	ScalarFunction contains_fun("range_contains", {range_type, bound_type}, LogicalType::BOOLEAN,
+	                            RangeContains<RANGE>);
+	RegisterRangeFunction(loader, contains_fun);
 
-	// Constructor: int4range(lower INT, upper INT) -> INT4RANGE (default bounds '[)')
-	ScalarFunction int4range_fun2("int4range", {LogicalType::INTEGER, LogicalType::INTEGER}, GetInt4RangeType(),
-	                              Int4RangeConstructor2);
-	loader.RegisterFunction(int4range_fun2);
+	// Contains operator @>
+	ScalarFunction contains_op("@>", {range_type, bound_type}, LogicalType::BOOLEAN, RangeContains<RANGE>);
+	RegisterRangeFunction(loader, contains_op);
 
-	// Constructor: int4range(varchar) -> INT4RANGE
-	ScalarFunction int4range_fun1("int4range", {LogicalType::VARCHAR}, GetInt4RangeType(), Int4RangeConstructor1);
-	loader.RegisterFunction(int4range_fun1);
+	// Contained by operator <@
+	ScalarFunction contained_op("<@", {bound_type, range_type}, LogicalType::BOOLEAN, RangeContainedBy<RANGE>);
+	RegisterRangeFunction(loader, contained_op);
 
-	// Constructor: int4range(lower INT, upper INT, lower_inc BOOLEAN, upper_inc BOOLEAN) -> INT4RANGE
-	ScalarFunction int4range_fun4(
-	    "int4range", {LogicalType::INTEGER, LogicalType::INTEGER, LogicalType::BOOLEAN, LogicalType::BOOLEAN},
-	    GetInt4RangeType(), Int4RangeConstructor4);
-	loader.RegisterFunction(int4range_fun4);
+	// Accessors: lower, upper -> bound type
+	ScalarFunction lower_fun("lower", {range_type}, bound_type, RangeBound<RANGE, false>);
+	lower_fun.statistics = RangeBoundAccessorStatistics<false>;
+	RegisterRangeFunction(loader, lower_fun);
 
-	// Cast: INT4RANGE -> VARCHAR
-	loader.RegisterCastFunction(GetInt4RangeType(), LogicalType::VARCHAR, BoundCastInfo(Int4RangeToVarchar), 1);
+	ScalarFunction upper_fun("upper", {range_type}, bound_type, RangeBound<RANGE, true>);
+	upper_fun.statistics = RangeBoundAccessorStatistics<true>;
+	RegisterRangeFunction(loader, upper_fun);
 
-	// Cast: VARCHAR -> INT4RANGE
-	loader.RegisterCastFunction(LogicalType::VARCHAR, GetInt4RangeType(), BoundCastInfo(VarcharToInt4RangeCast), 1);
+	// Accessors: isempty, lower_inc, upper_inc, lower_inf, upper_inf -> BOOLEAN
+	ScalarFunction isempty_fun("isempty", {range_type}, LogicalType::BOOLEAN, RangeIsEmpty<RANGE>);
+	RegisterRangeFunction(loader, isempty_fun);
 
-	// Operator: range_overlaps(INT4RANGE, INT4RANGE) -> BOOLEAN
-	ScalarFunction overlaps_fun("range_overlaps", {GetInt4RangeType(), GetInt4RangeType()}, LogicalType::BOOLEAN,
-	                            RangeOverlaps);
-	loader.RegisterFunction(overlaps_fun);
+	ScalarFunction lower_inc_fun("lower_inc", {range_type}, LogicalType::BOOLEAN, RangeLowerInc);
+	RegisterRangeFunction(loader, lower_inc_fun);
 
-	// Operator: range_contains(INT4RANGE, INTEGER) -> BOOLEAN
-	ScalarFunction contains_fun("range_contains", {GetInt4RangeType(), LogicalType::INTEGER}, LogicalType::BOOLEAN,
-	                            RangeContains);
-	loader.RegisterFunction(contains_fun);
+	ScalarFunction upper_inc_fun("upper_inc", {range_type}, LogicalType::BOOLEAN, RangeUpperInc);
+	RegisterRangeFunction(loader, upper_inc_fun);
 
-	// Contains operator @>
-	ScalarFunction contains_op("@>", {GetInt4RangeType(), LogicalType::INTEGER}, LogicalType::BOOLEAN, RangeContains);
-	loader.RegisterFunction(contains_op);
+	ScalarFunction lower_inf_fun("lower_inf", {range_type}, LogicalType::BOOLEAN, RangeLowerInf);
+	RegisterRangeFunction(loader, lower_inf_fun);
 
-	// Contained by operator <@
-	ScalarFunction contained_op("<@", {LogicalType::INTEGER, GetInt4RangeType()}, LogicalType::BOOLEAN,
-	                            RangeContainedBy);
-	loader.RegisterFunction(contained_op);
-
-	// Comparison operators for INT4RANGE (enables ORDER BY, indexing, etc.)
-	ScalarFunction range_lt("<", {GetInt4RangeType(), GetInt4RangeType()}, LogicalType::BOOLEAN, RangeLessThan);
-	loader.RegisterFunction(range_lt);
-
-	ScalarFunction range_lte("<=", {GetInt4RangeType(), GetInt4RangeType()}, LogicalType::BOOLEAN, RangeLessThanEquals);
-	loader.RegisterFunction(range_lte);
+	ScalarFunction upper_inf_fun("upper_inf", {range_type}, LogicalType::BOOLEAN, RangeUpperInf);
+	RegisterRangeFunction(loader, upper_inf_fun);
+
+	// Hash: range_hash(RANGE) -> UBIGINT
+	ScalarFunction hash_fun("range_hash", {range_type}, LogicalType::HASH, RangeHash);
+	RegisterRangeFunction(loader, hash_fun);
+}
+
+//===--------------------------------------------------------------------===//
+// Range Operators
+//===--------------------------------------------------------------------===//
+// Range-range operators, shared by all range types. The bounds are decoded once per row by the RangeReader and
+// the flat-vector paths of ExecuteRangeBinary stream them from the struct children; the predicates combine
+// their comparisons with bitwise operators so that each row evaluates without data-dependent branches.
+
+//! Lower bounds order by value, with an infinite bound before an inclusive one before an exclusive one at the
+//! same value
+template <class RANGE>
+static inline bool LowerBoundLess(const RANGE &a, const RANGE &b) {
+	return (a.lower < b.lower) |
+	       ((a.lower == b.lower) & ((a.lower_inc & !b.lower_inc) | (a.lower_inf & !b.lower_inf)));
+}
+
+//! Upper bounds order by value, with an exclusive bound before an inclusive one before an infinite one at the
+//! same value
+template <class RANGE>
+static inline bool UpperBoundLess(const RANGE &a, const RANGE &b) {
+	return (a.upper < b.upper) |
+	       ((a.upper == b.upper) & ((!a.upper_inc & b.upper_inc) | (!a.upper_inf & b.upper_inf)));
+}
+
+//! Copies the lower bound of from into range
+template <class RANGE>
+static inline void SetLowerBound(RANGE &range, const RANGE &from) {
+	range.lower = from.lower;
+	range.lower_inc = from.lower_inc;
+	range.lower_inf = from.lower_inf;
+}
+
+//! Copies the upper bound of from into range
+template <class RANGE>
+static inline void SetUpperBound(RANGE &range, const RANGE &from) {
+	range.upper = from.upper;
+	range.upper_inc = from.upper_inc;
+	range.upper_inf = from.upper_inf;
+}
 
-	ScalarFunction range_gt(">", {GetInt4RangeType(), GetInt4RangeType()}, LogicalType::BOOLEAN, RangeGreaterThan);
-	loader.RegisterFunction(range_gt);
+//! Whether a ends before b starts, so that they have no value in common
+template <class RANGE>
+static inline bool RangeBefore(const RANGE &a, const RANGE &b) {
+	return (a.upper < b.lower) | ((a.upper == b.lower) & !(a.upper_inc & b.lower_inc));
+}
+
+//! Whether b, which starts no earlier than a, overlaps or is adjacent to a, so that their union is one range
+template <class RANGE>
+static inline bool RangesTouch(const RANGE &a, const RANGE &b) {
+	return (b.lower < a.upper) | ((b.lower == a.upper) & (a.upper_inc | b.lower_inc));
+}
+
+//! Whether a ends exactly where b starts, with the shared bound in exactly one of them
+template <class RANGE>
+static inline bool RangeMeets(const RANGE &a, const RANGE &b) {
+	return (a.upper == b.lower) & (a.upper_inc != b.lower_inc);
+}
+
+template <class RANGE>
+static inline bool BothNonEmpty(const RANGE &a, const RANGE &b) {
+	return !(IsEmpty(a) | IsEmpty(b));
+}
 
-	ScalarFunction range_gte(">=", {GetInt4RangeType(), GetInt4RangeType()}, LogicalType::BOOLEAN,
-	                         RangeGreaterThanEquals);
-	loader.RegisterFunction(range_gte);
-
-	ScalarFunction range_eq("=", {GetInt4RangeType(), GetInt4RangeType()}, LogicalType::BOOLEAN, RangeEquals);
-	loader.RegisterFunction(range_eq);
-
-	ScalarFunction range_neq("!=", {GetInt4RangeType(), GetInt4RangeType()}, LogicalType::BOOLEAN, RangeNotEquals);
-	loader.RegisterFunction(range_neq);
-
-	ScalarFunction range_neq2("<>", {GetInt4RangeType(), GetInt4RangeType()}, LogicalType::BOOLEAN, RangeNotEquals);
-	loader.RegisterFunction(range_neq2);
-
-	// Accessor: lower(INT4RANGE) -> INTEGER
-	ScalarFunction lower_fun("lower", {GetInt4RangeType()}, LogicalType::INTEGER, RangeLower);
-	loader.RegisterFunction(lower_fun);
-
-	// Accessor: upper(INT4RANGE) -> INTEGER
-	ScalarFunction upper_fun("upper", {GetInt4RangeType()}, LogicalType::INTEGER, RangeUpper);
-	loader.RegisterFunction(upper_fun);
-
-	// Accessor: isempty(INT4RANGE) -> BOOLEAN
-	ScalarFunction isempty_fun("isempty", {GetInt4RangeType()}, LogicalType::BOOLEAN, RangeIsEmpty);
-	loader.RegisterFunction(isempty_fun);
-
-	// Accessor: lower_inc(INT4RANGE) -> BOOLEAN
-	ScalarFunction lower_inc_fun("lower_inc", {GetInt4RangeType()}, LogicalType::BOOLEAN, RangeLowerInc);
-	loader.RegisterFunction(lower_inc_fun);
-
-	// Accessor: upper_inc(INT4RANGE) -> BOOLEAN
-	ScalarFunction upper_inc_fun("upper_inc", {GetInt4RangeType()}, LogicalType::BOOLEAN, RangeUpperInc);
-	loader.RegisterFunction(upper_inc_fun);
-
-	//===--------------------------------------------------------------------===//
-	// NUMRANGE Registration
-	//===--------------------------------------------------------------------===//
-	loader.RegisterType("NUMRANGE", GetNumRangeType());
-
-	// Constructor: numrange(lower DOUBLE, upper DOUBLE, bounds VARCHAR) -> NUMRANGE
-	ScalarFunction numrange_fun("numrange", {LogicalType::DOUBLE, LogicalType::DOUBLE, LogicalType::VARCHAR},
-	                            GetNumRangeType(), NumRangeConstructor);
-	loader.RegisterFunction(numrange_fun);
-
-	// Constructor: numrange(lower DOUBLE, upper DOUBLE) -> NUMRANGE (default bounds '[)')
-	ScalarFunction numrange_fun2("numrange", {LogicalType::DOUBLE, LogicalType::DOUBLE}, GetNumRangeType(),
-	                             NumRangeConstructor2);
-	loader.RegisterFunction(numrange_fun2);
-
-	// Constructor: numrange(varchar) -> NUMRANGE
-	ScalarFunction numrange_fun1("numrange", {LogicalType::VARCHAR}, GetNumRangeType(), NumRangeConstructor1);
-	loader.RegisterFunction(numrange_fun1);
-
-	// Constructor: numrange(lower DOUBLE, upper DOUBLE, lower_inc BOOLEAN, upper_inc BOOLEAN) -> NUMRANGE
-	ScalarFunction numrange_fun4("numrange",
-	                             {LogicalType::DOUBLE, LogicalType::DOUBLE, LogicalType::BOOLEAN, LogicalType::BOOLEAN},
-	                             GetNumRangeType(), NumRangeConstructor4);
-	loader.RegisterFunction(numrange_fun4);
-
-	// Cast: NUMRANGE -> VARCHAR
-	loader.RegisterCastFunction(GetNumRangeType(), LogicalType::VARCHAR, BoundCastInfo(NumRangeToVarchar), 1);
-
-	// Cast: VARCHAR -> NUMRANGE
-	loader.RegisterCastFunction(LogicalType::VARCHAR, GetNumRangeType(), BoundCastInfo(VarcharToNumRangeCast), 1);
-
-	// Operator: range_overlaps(NUMRANGE, NUMRANGE) -> BOOLEAN
-	ScalarFunction num_overlaps_fun("range_overlaps", {GetNumRangeType(), GetNumRangeType()}, LogicalType::BOOLEAN,
-	                                NumRangeOverlaps);
-	loader.RegisterFunction(num_overlaps_fun);
-
-	// Operator: range_contains(NUMRANGE, DOUBLE) -> BOOLEAN
-	ScalarFunction num_contains_fun("range_contains", {GetNumRangeType(), LogicalType::DOUBLE}, LogicalType::BOOLEAN,
-	                                NumRangeContains);
-	loader.RegisterFunction(num_contains_fun);
-
-	// Contains operator @> for NUMRANGE
-	ScalarFunction num_contains_op("@>", {GetNumRangeType(), LogicalType::DOUBLE}, LogicalType::BOOLEAN,
-	                               NumRangeContains);
-	loader.RegisterFunction(num_contains_op);
-
-	// Contained by operator <@ for NUMRANGE
-	ScalarFunction num_contained_op("<@", {LogicalType::DOUBLE, GetNumRangeType()}, LogicalType::BOOLEAN,
-	                                NumRangeContainedBy);
-	loader.RegisterFunction(num_contained_op);
-
-	// Accessor: lower(NUMRANGE) -> DOUBLE
-	ScalarFunction num_lower_fun("lower", {GetNumRangeType()}, LogicalType::DOUBLE, NumRangeLower);
-	loader.RegisterFunction(num_lower_fun);
-
-	// Accessor: upper(NUMRANGE) -> DOUBLE
-	ScalarFunction num_upper_fun("upper", {GetNumRangeType()}, LogicalType::DOUBLE, NumRangeUpper);
-	loader.RegisterFunction(num_upper_fun);
-
-	// Accessor: isempty(NUMRANGE) -> BOOLEAN
-	ScalarFunction num_isempty_fun("isempty", {GetNumRangeType()}, LogicalType::BOOLEAN, NumRangeIsEmpty);
-	loader.RegisterFunction(num_isempty_fun);
-
-	// Accessor: lower_inc(NUMRANGE) -> BOOLEAN
-	ScalarFunction num_lower_inc_fun("lower_inc", {GetNumRangeType()}, LogicalType::BOOLEAN, NumRangeLowerInc);
-	loader.RegisterFunction(num_lower_inc_fun);
-
-	// Accessor: upper_inc(NUMRANGE) -> BOOLEAN
-	ScalarFunction num_upper_inc_fun("upper_inc", {GetNumRangeType()}, LogicalType::BOOLEAN, NumRangeUpperInc);
-	loader.RegisterFunction(num_upper_inc_fun);
+// a << b: a is strictly left of b
+struct RangeLeftOfOperator {
+	template <class RANGE>
+	static inline bool Operation(const RANGE &a, const RANGE &b) {
+		return BothNonEmpty(a, b) & RangeBefore(a, b);
+	}
+};
+
+// a >> b: a is strictly right of b
+struct RangeRightOfOperator {
+	template <class RANGE>
+	static inline bool Operation(const RANGE &a, const RANGE &b) {
+		return BothNonEmpty(a, b) & RangeBefore(b, a);
+	}
+};
+
+// a &< b: a does not extend to the right of b
+struct RangeNotRightOfOperator {
+	template <class RANGE>
+	static inline bool Operation(const RANGE &a, const RANGE &b) {
+		return BothNonEmpty(a, b) & !UpperBoundLess(b, a);
+	}
+};
+
+// a &> b: a does not extend to the left of b
+struct RangeNotLeftOfOperator {
+	template <class RANGE>
+	static inline bool Operation(const RANGE &a, const RANGE &b) {
+		return BothNonEmpty(a, b) & !LowerBoundLess(a, b);
+	}
+};
+
+// a -|- b: a and b are adjacent, their union is one range but they share no value
+struct RangeAdjacentOperator {
+	template <class RANGE>
+	static inline bool Operation(const RANGE &a, const RANGE &b) {
+		return BothNonEmpty(a, b) & (RangeMeets(a, b) | RangeMeets(b, a));
+	}
+};
+
+// a @> b: every value of b is in a. The empty range is contained in every range.
+struct RangeContainsRangeOperator {
+	template <class RANGE>
+	static inline bool Operation(const RANGE &a, const RANGE &b) {
+		return IsEmpty(b) | (!IsEmpty(a) & !LowerBoundLess(b, a) & !UpperBoundLess(a, b));
+	}
+};
+
+// a <@ b: every value of a is in b
+struct RangeContainedByRangeOperator {
+	template <class RANGE>
+	static inline bool Operation(const RANGE &a, const RANGE &b) {
+		return RangeContainsRangeOperator::Operation(b, a);
+	}
+};
+
+// a * b: intersection. The later lower and the earlier upper bound are picked with selects rather than
+// branches; if they cross, the result is empty, which canonicalization in the RangeWriter takes care of.
+// The encoding of the empty range has both bounds at the lowest value, so it needs no special case either.
+struct RangeIntersectOperator {
+	template <class RANGE>
+	static inline RANGE Operation(const RANGE &a, const RANGE &b) {
+		auto &lower = LowerBoundLess(a, b) ? b : a;
+		auto &upper = UpperBoundLess(a, b) ? a : b;
+		return RANGE {lower.lower, upper.upper, lower.lower_inc, upper.upper_inc, lower.lower_inf, upper.upper_inf};
+	}
+};
+
+// a + b: union. Like PostgreSQL this is an error if the ranges neither overlap nor touch.
+struct RangeUnionOperator {
+	template <class RANGE>
+	static inline RANGE Operation(const RANGE &a, const RANGE &b) {
+		if (IsEmpty(a)) {
+			return b;
+		}
+		if (IsEmpty(b)) {
+			return a;
+		}
+		auto a_first = !LowerBoundLess(b, a);
+		auto &first = a_first ? a : b;
+		auto &second = a_first ? b : a;
+		if (!RangesTouch(first, second)) {
+			throw InvalidInputException("Result of range union would not be contiguous");
+		}
+		auto &upper = UpperBoundLess(a, b) ? b : a;
+		return RANGE {first.lower, upper.upper, first.lower_inc, upper.upper_inc, first.lower_inf, upper.upper_inf};
+	}
+};
+
+// a - b: difference. Like PostgreSQL this is an error if b lies strictly inside a, splitting it in two.
+struct RangeDifferenceOperator {
+	template <class RANGE>
+	static inline RANGE Operation(const RANGE &a, const RANGE &b) {
+		if (IsEmpty(a) | IsEmpty(b) | RangeBefore(a, b) | RangeBefore(b, a)) {
+			return a;
+		}
+		auto keeps_left = LowerBoundLess(a, b);
+		auto keeps_right = UpperBoundLess(b, a);
+		if (keeps_left && keeps_right) {
+			throw InvalidInputException("Result of range difference would not be contiguous");
+		}
+		if (keeps_left) {
+			return RANGE {a.lower, b.lower, a.lower_inc, !b.lower_inc, a.lower_inf, false};
+		}
+		if (keeps_right) {
+			return RANGE {b.upper, a.upper, !b.upper_inc, a.upper_inc, false, a.upper_inf};
+		}
+		// b covers all of a
+		return EmptyRange<decltype(RANGE::lower)>();
+	}
+};
+
+template <class RANGE, class OP>
+static void RangePredicateFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	ExecuteRangeBinary<RangeReader<RANGE>, RangeReader<RANGE>, ValueWriter<bool>>(
+	    args.data[0], args.data[1], result, args.size(),
+	    [&](const RANGE &a, const RANGE &b) { return OP::Operation(a, b); });
+}
+
+template <class RANGE, class OP>
+static void RangeSetFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	ExecuteRangeBinary<RangeReader<RANGE>, RangeReader<RANGE>, RangeWriter<RANGE>>(
+	    args.data[0], args.data[1], result, args.size(),
+	    [&](const RANGE &a, const RANGE &b) { return OP::Operation(a, b); });
+}
+
+//! Registers the range-range operators of a range type
+template <class RANGE>
+static void RegisterRangeOperators(ExtensionLoader &loader) {
+	auto range_type = GetRangeType<decltype(RANGE::lower)>();
+	// Set operators: union (+), intersection (*) and difference (-)
+	loader.AddFunctionOverload(WithRangeStats(ScalarFunction("+", {range_type, range_type}, range_type,
+	                                                         RangeSetFunction<RANGE, RangeUnionOperator>)));
+	loader.AddFunctionOverload(WithRangeStats(ScalarFunction("*", {range_type, range_type}, range_type,
+	                                                         RangeSetFunction<RANGE, RangeIntersectOperator>)));
+	loader.AddFunctionOverload(WithRangeStats(ScalarFunction("-", {range_type, range_type}, range_type,
+	                                                         RangeSetFunction<RANGE, RangeDifferenceOperator>)));
+
+	// Overlaps operator &&, same as range_overlaps
+	ScalarFunction overlaps_op("&&", {range_type, range_type}, LogicalType::BOOLEAN, RangeOverlaps<RANGE>);
+	RegisterRangeFunction(loader, overlaps_op);
+
+	// Positional operators
+	ScalarFunction left_op("<<", {range_type, range_type}, LogicalType::BOOLEAN,
+	                       RangePredicateFunction<RANGE, RangeLeftOfOperator>);
+	RegisterRangeFunction(loader, left_op);
+
+	ScalarFunction right_op(">>", {range_type, range_type}, LogicalType::BOOLEAN,
+	                        RangePredicateFunction<RANGE, RangeRightOfOperator>);
+	RegisterRangeFunction(loader, right_op);
+
+	ScalarFunction not_right_op("&<", {range_type, range_type}, LogicalType::BOOLEAN,
+	                            RangePredicateFunction<RANGE, RangeNotRightOfOperator>);
+	RegisterRangeFunction(loader, not_right_op);
+
+	ScalarFunction not_left_op("&>", {range_type, range_type}, LogicalType::BOOLEAN,
+	                           RangePredicateFunction<RANGE, RangeNotLeftOfOperator>);
+	RegisterRangeFunction(loader, not_left_op);
+
+	ScalarFunction adjacent_op("-|-", {range_type, range_type}, LogicalType::BOOLEAN,
+	                           RangePredicateFunction<RANGE, RangeAdjacentOperator>);
+	RegisterRangeFunction(loader, adjacent_op);
+
+	// Range containment: range @> range, range <@ range
+	ScalarFunction contains_op("@>", {range_type, range_type}, LogicalType::BOOLEAN,
+	                           RangePredicateFunction<RANGE, RangeContainsRangeOperator>);
+	RegisterRangeFunction(loader, contains_op);
+
+	ScalarFunction contained_op("<@", {range_type, range_type}, LogicalType::BOOLEAN,
+	                            RangePredicateFunction<RANGE, RangeContainedByRangeOperator>);
+	RegisterRangeFunction(loader, contained_op);
+}
+
+//===--------------------------------------------------------------------===//
+// Aggregates
+//===--------------------------------------------------------------------===//
+// range_agg(range) -> LIST(range): the minimal list of disjoint ranges covering every input range
+// range_merge(range) -> range: the smallest single range covering every input range
+// Both ignore NULLs and empty ranges, and return NULL when there was no non-NULL input.
+
+//! Merges the touching ranges of a list of non-empty ranges sorted by lower bound
+template <class RANGE>
+static void MergeSortedRanges(vector<RANGE> &ranges) {
+	idx_t result_count = 0;
+	for (idx_t i = 0; i < ranges.size(); i++) {
+		auto &range = ranges[i];
+		if (result_count > 0 && RangesTouch(ranges[result_count - 1], range)) {
+			auto &last = ranges[result_count - 1];
+			if (UpperBoundLess(last, range)) {
+				SetUpperBound(last, range);
+			}
+			continue;
+		}
+		ranges[result_count++] = range;
+	}
+	ranges.resize(result_count);
+}
+
+//! Sorts non-empty ranges and merges the ones that touch, leaving the minimal set of disjoint ranges
+template <class RANGE>
+static void CoalesceRanges(vector<RANGE> &ranges) {
+	std::sort(ranges.begin(), ranges.end(), LowerBoundLess<RANGE>);
+	MergeSortedRanges(ranges);
+}
+
+template <class STATE>
+static idx_t RangeAggregateStateSize(const AggregateFunction &function) {
+	return sizeof(STATE);
+}
+
+template <class STATE>
+static void RangeAggregateInitialize(const AggregateFunction &function, data_ptr_t state) {
+	new (state) STATE();
+}
+
+template <class RANGE>
+struct RangeAggState {
+	//! nullptr until the first non-NULL input
+	vector<RANGE> *ranges;
+	//! Size of ranges after it was last coalesced
+	idx_t coalesced_count;
+
+	void Add(const RANGE &range) {
+		if (!ranges) {
+			ranges = new vector<RANGE>();
+		}
+		if (IsEmpty(range)) {
+			return;
+		}
+		ranges->push_back(range);
+		// Coalesce whenever the buffer doubles, so memory stays proportional to the result (amortized O(n log n))
+		if (ranges->size() >= 2 * coalesced_count + STANDARD_VECTOR_SIZE) {
+			CoalesceRanges(*ranges);
+			coalesced_count = ranges->size();
+		}
+	}
+
+	void Combine(const RangeAggState &other) {
+		if (!other.ranges) {
+			return;
+		}
+		if (!ranges) {
+			ranges = new vector<RANGE>();
+		}
+		ranges->insert(ranges->end(), other.ranges->begin(), other.ranges->end());
+		CoalesceRanges(*ranges);
+		coalesced_count = ranges->size();
+	}
+};
+
+template <class RANGE>
+struct RangeMergeState {
+	bool has_input;
+	bool has_range;
+	RANGE bounds;
+
+	void Add(const RANGE &range) {
+		has_input = true;
+		if (IsEmpty(range)) {
+			return;
+		}
+		if (!has_range) {
+			bounds = range;
+			has_range = true;
+			return;
+		}
+		if (LowerBoundLess(range, bounds)) {
+			SetLowerBound(bounds, range);
+		}
+		if (UpperBoundLess(bounds, range)) {
+			SetUpperBound(bounds, range);
+		}
+	}
+
+	void Combine(const RangeMergeState &other) {
+		if (other.has_range) {
+			Add(other.bounds);
+		} else if (other.has_input) {
+			has_input = true;
+		}
+	}
+};
+
+template <class STATE, class RANGE>
+static void RangeAggregateUpdate(Vector inputs[], AggregateInputData &aggr_input_data, idx_t input_count,
+                                 Vector &state_vector, idx_t count) {
+	RangeReader<RANGE> input(inputs[0], count);
+	UnifiedVectorFormat sdata;
+	state_vector.ToUnifiedFormat(count, sdata);
+	auto states = UnifiedVectorFormat::GetData<STATE *>(sdata);
+	for (idx_t i = 0; i < count; i++) {
+		if (!input.RowIsValid(i)) {
+			continue;
+		}
+		states[sdata.sel->get_index(i)]->Add(input.Get(i));
+	}
+}
+
+template <class STATE, class RANGE>
+static void RangeAggregateSimpleUpdate(Vector inputs[], AggregateInputData &aggr_input_data, idx_t input_count,
+                                       data_ptr_t state_ptr, idx_t count) {
+	RangeReader<RANGE> input(inputs[0], count);
+	auto &state = *reinterpret_cast<STATE *>(state_ptr);
+	for (idx_t i = 0; i < count; i++) {
+		if (input.RowIsValid(i)) {
+			state.Add(input.Get(i));
+		}
+	}
+}
+
+template <class STATE>
+static void RangeAggregateCombine(Vector &source, Vector &target, AggregateInputData &aggr_input_data, idx_t count) {
+	auto source_states = FlatVector::GetData<STATE *>(source);
+	auto target_states = FlatVector::GetData<STATE *>(target);
+	for (idx_t i = 0; i < count; i++) {
+		target_states[i]->Combine(*source_states[i]);
+	}
+}
+
+template <class RANGE>
+static void RangeAggDestroy(Vector &state_vector, AggregateInputData &aggr_input_data, idx_t count) {
+	auto states = FlatVector::GetData<RangeAggState<RANGE> *>(state_vector);
+	for (idx_t i = 0; i < count; i++) {
+		delete states[i]->ranges;
+		states[i]->ranges = nullptr;
+	}
+}
+
+template <class RANGE>
+static void RangeAggFinalize(Vector &state_vector, AggregateInputData &aggr_input_data, Vector &result, idx_t count,
+                             idx_t offset) {
+	UnifiedVectorFormat sdata;
+	state_vector.ToUnifiedFormat(count, sdata);
+	auto states = UnifiedVectorFormat::GetData<RangeAggState<RANGE> *>(sdata);
+	MultirangeWriter<RANGE> writer(result);
+	for (idx_t i = 0; i < count; i++) {
+		auto &state = *states[sdata.sel->get_index(i)];
+		auto row = i + offset;
+		if (!state.ranges) {
+			FlatVector::SetNull(result, row, true);
+			continue;
+		}
+		CoalesceRanges(*state.ranges);
+		writer.Set(row, *state.ranges);
+	}
+}
+
+template <class RANGE>
+static void RangeMergeFinalize(Vector &state_vector, AggregateInputData &aggr_input_data, Vector &result, idx_t count,
+                               idx_t offset) {
+	UnifiedVectorFormat sdata;
+	state_vector.ToUnifiedFormat(count, sdata);
+	auto states = UnifiedVectorFormat::GetData<RangeMergeState<RANGE> *>(sdata);
+	RangeWriter<RANGE> writer(result);
+	for (idx_t i = 0; i < count; i++) {
+		auto &state = *states[sdata.sel->get_index(i)];
+		auto row = i + offset;
+		if (!state.has_input) {
+			FlatVector::SetNull(result, row, true);
+			continue;
+		}
+		// Without any non-empty input the result is the empty range
+		writer.Set(row, state.has_range ? state.bounds : EmptyRange<decltype(RANGE::lower)>());
+	}
+}
+
+template <class RANGE>
+static AggregateFunction GetRangeAggFunction(const LogicalType &range_type) {
+	using STATE = RangeAggState<RANGE>;
+	AggregateFunction function("range_agg", {range_type}, LogicalType::LIST(range_type),
+	                           RangeAggregateStateSize<STATE>, RangeAggregateInitialize<STATE>,
+	                           RangeAggregateUpdate<STATE, RANGE>, RangeAggregateCombine<STATE>,
+	                           RangeAggFinalize<RANGE>, RangeAggregateSimpleUpdate<STATE, RANGE>);
+	function.destructor = RangeAggDestroy<RANGE>;
+	return function;
+}
+
+template <class RANGE>
+static AggregateFunction GetRangeMergeFunction(const LogicalType &range_type) {
+	using STATE = RangeMergeState<RANGE>;
+	return AggregateFunction("range_merge", {range_type}, range_type, RangeAggregateStateSize<STATE>,
+	                         RangeAggregateInitialize<STATE>, RangeAggregateUpdate<STATE, RANGE>,
+	                         RangeAggregateCombine<STATE>, RangeMergeFinalize<RANGE>,
+	                         RangeAggregateSimpleUpdate<STATE, RANGE>);
+}
+
+template <class RANGE>
+static void AddRangeAggregates(AggregateFunctionSet &range_agg_set, AggregateFunctionSet &range_merge_set) {
+	auto range_type = GetRangeType<decltype(RANGE::lower)>();
+	range_agg_set.AddFunction(GetRangeAggFunction<RANGE>(range_type));
+	range_merge_set.AddFunction(GetRangeMergeFunction<RANGE>(range_type));
+}
+
+// range_coalesce(tbl, partition_col, range_col) -> TABLE(partition_col, island): the islands of a gaps-and-islands
+// analysis, i.e. the maximal ranges formed by each partition's overlapping and adjacent ranges. It is a table
+// macro over range_agg, so the partitions are hash-aggregated in parallel and each one is sorted and merged once,
+// instead of running the usual stack of window functions. The table is given by name, e.g.
+// `FROM range_coalesce('bookings', room, stay)`.
+static const DefaultTableMacro RANGE_COALESCE_MACRO = {
+    DEFAULT_SCHEMA,
+    "range_coalesce",
+    {"tbl", "partition_col", "range_col", nullptr},
+    {{nullptr, nullptr}},
+    "SELECT partition_col, unnest(range_agg(range_col)) AS island FROM query_table(tbl) GROUP BY partition_col"};
+
+//===--------------------------------------------------------------------===//
+// Multiranges
+//===--------------------------------------------------------------------===//
+// Each range type has a multirange type (INT4MULTIRANGE, NUMMULTIRANGE, ...) holding a set of values as a sorted
+// list of disjoint ranges (see Physical Layout). Membership is a binary search over the elements, and union,
+// intersection and difference are single merge passes over two sorted lists. The text form follows PostgreSQL:
+// '{[1,3),[5,7)}', with '{}' when empty.
+
+template <class T>
+static LogicalType GetMultirangeType() {
+	return MakeMultirangeType(GetRangeType<T>(), RangeTraits<T>::MultirangeTypeName());
+}
+
+//! Whether every value of the range is smaller than value
+template <class RANGE, class T>
+static inline bool RangeEndsBefore(const RANGE &range, T value) {
+	return range.upper < value || (range.upper == value && !range.upper_inc);
+}
+
+//! Brings arbitrary ranges into the multirange form: canonical, non-empty, sorted and coalesced
+template <class RANGE>
+static void NormalizeMultirange(vector<RANGE> &ranges) {
+	idx_t result_count = 0;
+	for (idx_t i = 0; i < ranges.size(); i++) {
+		auto range = ranges[i];
+		if (CanonicalizeRange(range)) {
+			ranges[result_count++] = range;
+		}
+	}
+	ranges.resize(result_count);
+	CoalesceRanges(ranges);
+}
+
+//! Binary search for value over the elements entry.offset .. entry.offset + entry.length of a multirange
+template <class RANGE, class T>
+static bool MultirangeContainsValue(const RangeReader<RANGE> &ranges, const list_entry_t &entry, T value) {
+	// The elements are disjoint and sorted, so their upper bounds are sorted as well: find the first element
+	// that does not end before value, which is the only one that can contain it
+	auto lo = entry.offset;
+	auto hi = entry.offset + entry.length;
+	while (lo < hi) {
+		auto mid = lo + (hi - lo) / 2;
+		if (RangeEndsBefore(ranges.Get(mid), value)) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo < entry.offset + entry.length && ContainsValue(ranges.Get(lo), value);
+}
+
+struct MultirangeUnionOperator {
+	template <class RANGE>
+	static void Operation(const vector<RANGE> &a, const vector<RANGE> &b, vector<RANGE> &result) {
+		result.resize(a.size() + b.size());
+		std::merge(a.begin(), a.end(), b.begin(), b.end(), result.begin(), LowerBoundLess<RANGE>);
+		MergeSortedRanges(result);
+	}
+};
+
+struct MultirangeIntersectOperator {
+	template <class RANGE>
+	static void Operation(const vector<RANGE> &a, const vector<RANGE> &b, vector<RANGE> &result) {
+		result.clear();
+		idx_t i = 0;
+		idx_t j = 0;
+		while (i < a.size() && j < b.size()) {
+			// The overlap of two elements starts at the later lower bound and ends at the earlier upper bound
+			auto a_ends_first = UpperBoundLess(a[i], b[j]);
+			auto piece = LowerBoundLess(a[i], b[j]) ? b[j] : a[i];
+			SetUpperBound(piece, a_ends_first ? a[i] : b[j]);
+			if (CanonicalizeRange(piece)) {
+				result.push_back(piece);
+			}
+			if (a_ends_first) {
+				i++;
+			} else {
+				j++;
+			}
+		}
+	}
+};
+
+struct MultirangeDifferenceOperator {
+	template <class RANGE>
+	static void Operation(const vector<RANGE> &a, const vector<RANGE> &b, vector<RANGE> &result) {
+		result.clear();
+		idx_t j = 0;
+		for (auto &range : a) {
+			// Elements of b that end before this element also end before every later element of a
+			while (j < b.size() && RangeBefore(b[j], range)) {
+				j++;
+			}
+			auto rest = range;
+			auto has_rest = true;
+			for (auto k = j; k < b.size() && !RangeBefore(rest, b[k]); k++) {
+				// Keep the part before b[k], and continue with the part after it
+				auto piece = rest;
+				piece.upper = b[k].lower;
+				piece.upper_inc = !b[k].lower_inc;
+				piece.upper_inf = false;
+				if (CanonicalizeRange(piece)) {
+					result.push_back(piece);
+				}
+				if (!UpperBoundLess(b[k], rest)) {
+					has_rest = false;
+					break;
+				}
+				rest.lower = b[k].upper;
+				rest.lower_inc = !b[k].upper_inc;
+				rest.lower_inf = false;
+			}
+			if (has_rest && CanonicalizeRange(rest)) {
+				result.push_back(rest);
+			}
+		}
+	}
+};
+
+template <class RANGE, class OP>
+static void MultirangeSetFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto count = args.size();
+	MultirangeReader<RANGE> a(args.data[0], count);
+	MultirangeReader<RANGE> b(args.data[1], count);
+	auto is_constant = args.data[0].GetVectorType() == VectorType::CONSTANT_VECTOR &&
+	                   args.data[1].GetVectorType() == VectorType::CONSTANT_VECTOR;
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	MultirangeWriter<RANGE> writer(result);
+	vector<RANGE> a_ranges;
+	vector<RANGE> b_ranges;
+	vector<RANGE> result_ranges;
+	auto row_count = is_constant ? 1 : count;
+	for (idx_t i = 0; i < row_count; i++) {
+		if (!a.RowIsValid(i) || !b.RowIsValid(i)) {
+			FlatVector::SetNull(result, i, true);
+			continue;
+		}
+		a.Get(i, a_ranges);
+		b.Get(i, b_ranges);
+		OP::Operation(a_ranges, b_ranges, result_ranges);
+		writer.Set(i, result_ranges);
+	}
+	if (is_constant) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	}
+}
+
+//! int4multirange(range, ...) / nummultirange(range, ...): the union of the arguments, NULL if any is NULL
+template <class RANGE>
+static void MultirangeConstructor(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto count = args.size();
+	vector<unique_ptr<RangeReader<RANGE>>> inputs;
+	auto is_constant = true;
+	for (auto &input : args.data) {
+		inputs.push_back(make_uniq<RangeReader<RANGE>>(input, count));
+		is_constant = is_constant && input.GetVectorType() == VectorType::CONSTANT_VECTOR;
+	}
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	MultirangeWriter<RANGE> writer(result);
+	vector<RANGE> ranges;
+	auto row_count = is_constant ? 1 : count;
+	for (idx_t i = 0; i < row_count; i++) {
+		ranges.clear();
+		auto row_is_valid = true;
+		for (auto &input : inputs) {
+			if (!input->RowIsValid(i)) {
+				row_is_valid = false;
+				break;
+			}
+			ranges.push_back(input->Get(i));
+		}
+		if (!row_is_valid) {
+			FlatVector::SetNull(result, i, true);
+			continue;
+		}
+		NormalizeMultirange(ranges);
+		writer.Set(i, ranges);
+	}
+	if (is_constant) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	}
+}
+
+template <class RANGE>
+static void MultirangeContains(DataChunk &args, ExpressionState &state, Vector &result) {
+	using BOUND_TYPE = decltype(RANGE::lower);
+	auto &multirange_vec = args.data[0];
+	RangeReader<RANGE> ranges(ListVector::GetEntry(multirange_vec), ListVector::GetListSize(multirange_vec));
+	ExecuteRangeBinary<ValueReader<list_entry_t>, ValueReader<BOUND_TYPE>, ValueWriter<bool>>(
+	    multirange_vec, args.data[1], result, args.size(),
+	    [&](const list_entry_t &entry, BOUND_TYPE value) { return MultirangeContainsValue(ranges, entry, value); });
+}
+
+template <class RANGE>
+static void MultirangeContainedBy(DataChunk &args, ExpressionState &state, Vector &result) {
+	using BOUND_TYPE = decltype(RANGE::lower);
+	auto &multirange_vec = args.data[1];
+	RangeReader<RANGE> ranges(ListVector::GetEntry(multirange_vec), ListVector::GetListSize(multirange_vec));
+	ExecuteRangeBinary<ValueReader<BOUND_TYPE>, ValueReader<list_entry_t>, ValueWriter<bool>>(
+	    args.data[0], multirange_vec, result, args.size(),
+	    [&](BOUND_TYPE value, const list_entry_t &entry) { return MultirangeContainsValue(ranges, entry, value); });
+}
+
+// Accessor: isempty(MULTIRANGE) -> BOOLEAN
+static void MultirangeIsEmpty(DataChunk &args, ExpressionState &state, Vector &result) {
+	UnaryExecutor::Execute<list_entry_t, bool>(args.data[0], result, args.size(),
+	                                           [&](const list_entry_t &entry) { return entry.length == 0; });
+}
+
+// Accessors: lower(MULTIRANGE) / upper(MULTIRANGE) -> bound type, the bounds of the first / last element.
+// NULL for the empty multirange and for an infinite bound, like PostgreSQL.
+template <class RANGE, bool UPPER>
+static void MultirangeBound(DataChunk &args, ExpressionState &state, Vector &result) {
+	using BOUND_TYPE = decltype(RANGE::lower);
+	auto &input = args.data[0];
+	auto count = args.size();
+	MultirangeReader<RANGE> multiranges(input, count);
+	auto is_constant = input.GetVectorType() == VectorType::CONSTANT_VECTOR;
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<BOUND_TYPE>(result);
+	auto row_count = is_constant ? 1 : count;
+	for (idx_t i = 0; i < row_count; i++) {
+		if (!multiranges.RowIsValid(i) || multiranges.lists.Get(i).length == 0) {
+			FlatVector::SetNull(result, i, true);
+			continue;
+		}
+		auto entry = multiranges.lists.Get(i);
+		auto range = multiranges.ranges.Get(UPPER ? entry.offset + entry.length - 1 : entry.offset);
+		if (UPPER ? range.upper_inf : range.lower_inf) {
+			FlatVector::SetNull(result, i, true);
+			continue;
+		}
+		result_data[i] = UPPER ? range.upper : range.lower;
+	}
+	if (is_constant) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	}
+}
+
+//! Parses a multirange literal such as '{[1,3), [5,7)}' into its ranges, which are not normalized yet
+template <class RANGE>
+static RangeParseResult TryParseMultirange(const string_t &input, vector<RANGE> &ranges) {
+	auto data = input.GetData();
+	auto size = input.GetSize();
+	idx_t pos = 0;
+	auto skip_spaces = [&]() {
+		while (pos < size && StringUtil::CharacterIsSpace(data[pos])) {
+			pos++;
+		}
+	};
+	ranges.clear();
+	skip_spaces();
+	if (pos >= size || data[pos] != '{') {
+		return RangeParseResult::MALFORMED;
+	}
+	pos++;
+	skip_spaces();
+	if (pos < size && data[pos] == '}') {
+		pos++;
+		skip_spaces();
+		return pos == size ? RangeParseResult::SUCCESS : RangeParseResult::MALFORMED;
+	}
+	while (true) {
+		skip_spaces();
+		auto start = pos;
+		if (pos < size && (data[pos] == '[' || data[pos] == '(')) {
+			// Bounds cannot contain brackets, so the element ends at the first closing one
+			while (pos < size && data[pos] != ']' && data[pos] != ')') {
+				pos++;
+			}
+			if (pos == size) {
+				return RangeParseResult::MALFORMED;
+			}
+			pos++;
+		} else {
+			while (pos < size && data[pos] != ',' && data[pos] != '}' && !StringUtil::CharacterIsSpace(data[pos])) {
+				pos++;
+			}
+		}
+		RANGE range;
+		auto status = TryParseRange(string_t(data + start, UnsafeNumericCast<uint32_t>(pos - start)), range);
+		if (status != RangeParseResult::SUCCESS) {
+			return status;
+		}
+		ranges.push_back(range);
+		skip_spaces();
+		if (pos >= size) {
+			return RangeParseResult::MALFORMED;
+		}
+		if (data[pos] == '}') {
+			break;
+		}
+		if (data[pos] != ',') {
+			return RangeParseResult::MALFORMED;
+		}
+		pos++;
+	}
+	pos++;
+	skip_spaces();
+	return pos == size ? RangeParseResult::SUCCESS : RangeParseResult::MALFORMED;
+}
+
+static string MultirangeParseErrorMessage(RangeParseResult status, const string_t &input, const char *bound_kind) {
+	if (status == RangeParseResult::INVALID_BOUND) {
+		return StringUtil::Format("Invalid %s in multirange literal: \"%s\"", bound_kind, input.GetString());
+	}
+	return StringUtil::Format("Malformed multirange literal: \"%s\"", input.GetString());
+}
+
+//! VARCHAR -> multirange cast. Under TRY_CAST a malformed literal becomes NULL instead of raising an error.
+template <class RANGE>
+static bool VarcharToMultirangeCast(Vector &source, Vector &result, idx_t count, CastParameters &parameters) {
+	vector<RANGE> ranges;
+	auto parsed = ExecuteParseDictionary<MultirangeWriter<RANGE>>(
+	    source, result, count, [&](const string_t &input, MultirangeWriter<RANGE> &writer, idx_t i) {
+		    if (TryParseMultirange(input, ranges) != RangeParseResult::SUCCESS) {
+			    return false;
+		    }
+		    NormalizeMultirange(ranges);
+		    writer.Set(i, ranges);
+		    return true;
+	    });
+	if (parsed) {
+		RecordRangeCast(parameters, count, 0, 0);
+		auto site = RangeCastStatsSite(parameters);
+		if (site) {
+			site->Add(RangeStatsCounter::DICTIONARY_CHUNKS, 1);
+		}
+		return true;
+	}
+	auto bound_kind = RangeTraits<decltype(RANGE::lower)>::BoundName();
+	ValueReader<string_t> source_data(source, count);
+	auto is_constant = source.GetVectorType() == VectorType::CONSTANT_VECTOR;
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	MultirangeWriter<RANGE> writer(result);
+	bool all_converted = true;
+	idx_t parse_errors = 0;
+	auto row_count = is_constant ? 1 : count;
+	for (idx_t i = 0; i < row_count; i++) {
+		if (!source_data.RowIsValid(i)) {
+			FlatVector::SetNull(result, i, true);
+			continue;
+		}
+		auto input = source_data.Get(i);
+		auto status = TryParseMultirange(input, ranges);
+		if (status != RangeParseResult::SUCCESS) {
+			HandleCastError::AssignError(MultirangeParseErrorMessage(status, input, bound_kind), parameters);
+			FlatVector::SetNull(result, i, true);
+			all_converted = false;
+			parse_errors++;
+			continue;
+		}
+		NormalizeMultirange(ranges);
+		writer.Set(i, ranges);
+	}
+	if (is_constant) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	}
+	RecordRangeCast(parameters, count, parse_errors, 0);
+	return all_converted;
+}
+
+//! Multirange -> VARCHAR cast, rendering every element into one reused buffer
+template <class RANGE>
+static bool MultirangeToVarcharCast(Vector &source, Vector &result, idx_t count, CastParameters &parameters) {
+	MultirangeReader<RANGE> source_data(source, count);
+	auto is_constant = source.GetVectorType() == VectorType::CONSTANT_VECTOR;
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<string_t>(result);
+	string text;
+	uint64_t text_bytes = 0;
+	char buffer[RANGE_TEXT_BUFFER_SIZE];
+	auto row_count = is_constant ? 1 : count;
+	for (idx_t i = 0; i < row_count; i++) {
+		if (!source_data.RowIsValid(i)) {
+			FlatVector::SetNull(result, i, true);
+			continue;
+		}
+		auto entry = source_data.lists.Get(i);
+		text = "{";
+		for (idx_t k = entry.offset; k < entry.offset + entry.length; k++) {
+			if (k > entry.offset) {
+				text += ',';
+			}
+			text.append(buffer, FormatRange(source_data.ranges.Get(k), false, buffer));
+		}
+		text += '}';
+		result_data[i] = StringVector::AddString(result, text);
+		text_bytes += text.size();
+	}
+	if (is_constant) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	}
+	RecordRangeCast(parameters, count, 0, text_bytes);
+	return true;
+}
+
+//! LIST(range) -> multirange cast (implicit), e.g. for the result of range_agg. NULL elements are dropped.
+template <class RANGE>
+static bool ListToMultirangeCast(Vector &source, Vector &result, idx_t count, CastParameters &parameters) {
+	MultirangeReader<RANGE> source_data(source, count);
+	auto is_constant = source.GetVectorType() == VectorType::CONSTANT_VECTOR;
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	MultirangeWriter<RANGE> writer(result);
+	vector<RANGE> ranges;
+	auto row_count = is_constant ? 1 : count;
+	for (idx_t i = 0; i < row_count; i++) {
+		if (!source_data.RowIsValid(i)) {
+			FlatVector::SetNull(result, i, true);
+			continue;
+		}
+		source_data.Get(i, ranges);
+		NormalizeMultirange(ranges);
+		writer.Set(i, ranges);
+	}
+	if (is_constant) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	}
+	RecordRangeCast(parameters, count, 0, 0);
+	return true;
+}
+
+//! Registers the multirange type over RANGE with its constructor, casts, operators and accessors
+template <class RANGE>
+static void RegisterMultirangeType(ExtensionLoader &loader) {
+	using BOUND_TYPE = decltype(RANGE::lower);
+	auto multirange_type = GetMultirangeType<BOUND_TYPE>();
+	auto range_type = GetRangeType<BOUND_TYPE>();
+	auto bound_type = RangeTraits<BOUND_TYPE>::BoundType();
+	loader.RegisterType(RangeTraits<BOUND_TYPE>::MultirangeTypeName(), multirange_type);
+
+	// Constructor: int4multirange(range, ...) -> multirange
+	auto constructor_name = StringUtil::Lower(RangeTraits<BOUND_TYPE>::MultirangeTypeName());
+	ScalarFunction constructor(constructor_name, {}, multirange_type, MultirangeConstructor<RANGE>);
+	constructor.varargs = range_type;
+	RegisterRangeFunction(loader, constructor);
+
+	// Casts: multirange <-> VARCHAR, LIST(range) -> multirange
+	auto multirange_name = string(RangeTraits<BOUND_TYPE>::MultirangeTypeName());
+	loader.RegisterCastFunction(multirange_type, LogicalType::VARCHAR,
+	                            RangeCastInfo(MultirangeToVarcharCast<RANGE>, multirange_name + " -> VARCHAR"), 1);
+	loader.RegisterCastFunction(LogicalType::VARCHAR, multirange_type,
+	                            RangeCastInfo(VarcharToMultirangeCast<RANGE>, "VARCHAR -> " + multirange_name), 1);
+	loader.RegisterCastFunction(LogicalType::LIST(range_type), multirange_type,
+	                            RangeCastInfo(ListToMultirangeCast<RANGE>, "LIST -> " + multirange_name), 1);
+
+	// Operators: multirange @> value, value <@ multirange, range_contains(multirange, value)
+	ScalarFunction contains_op("@>", {multirange_type, bound_type}, LogicalType::BOOLEAN, MultirangeContains<RANGE>);
+	RegisterRangeFunction(loader, contains_op);
+
+	ScalarFunction contained_op("<@", {bound_type, multirange_type}, LogicalType::BOOLEAN,
+	                            MultirangeContainedBy<RANGE>);
+	RegisterRangeFunction(loader, contained_op);
+
+	ScalarFunction contains_fun("range_contains", {multirange_type, bound_type}, LogicalType::BOOLEAN,
+	                            MultirangeContains<RANGE>);
+	RegisterRangeFunction(loader, contains_fun);
+
+	// Set operators: union (+), intersection (*) and difference (-)
+	ScalarFunction union_op("+", {multirange_type, multirange_type}, multirange_type,
+	                        MultirangeSetFunction<RANGE, MultirangeUnionOperator>);
+	loader.AddFunctionOverload(WithRangeStats(union_op));
+
+	ScalarFunction intersect_op("*", {multirange_type, multirange_type}, multirange_type,
+	                            MultirangeSetFunction<RANGE, MultirangeIntersectOperator>);
+	loader.AddFunctionOverload(WithRangeStats(intersect_op));
+
+	ScalarFunction difference_op("-", {multirange_type, multirange_type}, multirange_type,
+	                             MultirangeSetFunction<RANGE, MultirangeDifferenceOperator>);
+	loader.AddFunctionOverload(WithRangeStats(difference_op));
+
+	// Accessors: isempty, lower, upper
+	ScalarFunction isempty_fun("isempty", {multirange_type}, LogicalType::BOOLEAN, MultirangeIsEmpty);
+	RegisterRangeFunction(loader, isempty_fun);
+
+	ScalarFunction lower_fun("lower", {multirange_type}, bound_type, MultirangeBound<RANGE, false>);
+	RegisterRangeFunction(loader, lower_fun);
+
+	ScalarFunction upper_fun("upper", {multirange_type}, bound_type, MultirangeBound<RANGE, true>);
+	RegisterRangeFunction(loader, upper_fun);
+}
+
+//===--------------------------------------------------------------------===//
+// Range Lookup
+//===--------------------------------------------------------------------===//
+// range_lookup(ranges LIST(range), value) -> LIST(BIGINT): the 1-based positions of the ranges in the list that
+// contain value. The list has to be a constant (a literal or getvariable()), so the lookup structure is built
+// once at bind time and then probed read-only by every thread executing the query. It holds the non-empty
+// ranges sorted by lower bound, along with the furthest upper bound reached by any range up to each one: a probe
+// binary searches the last range starting at or before the value and walks back only while that running upper
+// bound still reaches it, which for mostly disjoint ranges like pricing bands touches one or two entries.
+//
+// range_bucket(value, ranges LIST(range)) -> BIGINT: the position of the one range containing value, for lists
+// of non-overlapping ranges such as histogram buckets. As at most one range can match, the lower bounds are laid
+// out in Eytzinger (breadth-first) order, which a probe descends without branches and with the top levels
+// shared in cache across all probes, followed by a single containment check.
+
+//! Whether every value of the range is larger than value
+template <class RANGE, class T>
+static inline bool RangeStartsAfter(const RANGE &range, T value) {
+	return (value < range.lower) || (value == range.lower && !range.lower_inc);
+}
+
+//! Collects the non-empty ranges of a constant list with their 1-based positions, sorted by lower bound
+template <class RANGE>
+static void CollectListRanges(const Value &list, vector<std::pair<RANGE, int64_t>> &entries) {
+	Vector list_vec(list);
+	auto entry = ConstantVector::GetData<list_entry_t>(list_vec)[0];
+	RangeReader<RANGE> input(ListVector::GetEntry(list_vec), entry.offset + entry.length);
+	for (idx_t i = 0; i < entry.length; i++) {
+		auto row = entry.offset + i;
+		if (!input.RowIsValid(row) || IsEmpty(input.Get(row))) {
+			continue;
+		}
+		entries.emplace_back(input.Get(row), int64_t(i + 1));
+	}
+	std::sort(entries.begin(), entries.end(),
+	          [](const std::pair<RANGE, int64_t> &a, const std::pair<RANGE, int64_t> &b) {
+		          return LowerBoundLess(a.first, b.first);
+	          });
+}
+
+template <class RANGE>
+struct RangeLookupIndex {
+	using BOUND_TYPE = decltype(RANGE::lower);
+
+	//! Non-empty ranges sorted by lower bound, and their positions in the input list
+	vector<RANGE> ranges;
+	vector<int64_t> positions;
+	//! reach[i] has the furthest upper bound of ranges[0] .. ranges[i]
+	vector<RANGE> reach;
+
+	void Build(const Value &list) {
+		vector<std::pair<RANGE, int64_t>> entries;
+		CollectListRanges(list, entries);
+		for (auto &range_entry : entries) {
+			ranges.push_back(range_entry.first);
+			positions.push_back(range_entry.second);
+			reach.push_back(range_entry.first);
+			if (reach.size() > 1 && UpperBoundLess(range_entry.first, reach[reach.size() - 2])) {
+				SetUpperBound(reach.back(), reach[reach.size() - 2]);
+			}
+		}
+	}
+
+	//! Collects the positions of the ranges containing value, in list order
+	void Probe(BOUND_TYPE value, vector<int64_t> &matches) const {
+		matches.clear();
+		idx_t end = 0;
+		idx_t hi = ranges.size();
+		while (end < hi) {
+			auto mid = end + (hi - end) / 2;
+			if (RangeStartsAfter(ranges[mid], value)) {
+				hi = mid;
+			} else {
+				end = mid + 1;
+			}
+		}
+		for (auto i = end; i > 0 && !RangeEndsBefore(reach[i - 1], value); i--) {
+			if (ContainsValue(ranges[i - 1], value)) {
+				matches.push_back(positions[i - 1]);
+			}
+		}
+		std::sort(matches.begin(), matches.end());
+	}
+};
+
+template <class RANGE>
+struct RangeBucketIndex {
+	using BOUND_TYPE = decltype(RANGE::lower);
+
+	//! Lower bounds in Eytzinger order: slot k (starting at 1) has the children 2k and 2k + 1, and order[k] is the
+	//! index of its range in ranges
+	vector<BOUND_TYPE> lowers;
+	vector<uint8_t> lower_inc;
+	vector<idx_t> order;
+	//! Non-empty ranges sorted by lower bound, and their positions in the input list
+	vector<RANGE> ranges;
+	vector<int64_t> positions;
+
+	void Build(const Value &list) {
+		vector<std::pair<RANGE, int64_t>> entries;
+		CollectListRanges(list, entries);
+		for (auto &range_entry : entries) {
+			if (!ranges.empty() && !RangeBefore(ranges.back(), range_entry.first)) {
+				throw BinderException("range_bucket: the ranges must not overlap, use range_lookup instead");
+			}
+			ranges.push_back(range_entry.first);
+			positions.push_back(range_entry.second);
+		}
+		lowers.resize(ranges.size() + 1);
+		lower_inc.resize(ranges.size() + 1);
+		order.resize(ranges.size() + 1);
+		idx_t next = 0;
+		FillSlots(1, next);
+	}
+
+	//! Assigns the sorted ranges to the slots below k with an in-order walk of the implicit tree
+	void FillSlots(idx_t k, idx_t &next) {
+		if (k > ranges.size()) {
+			return;
+		}
+		FillSlots(2 * k, next);
+		lowers[k] = ranges[next].lower;
+		lower_inc[k] = ranges[next].lower_inc;
+		order[k] = next++;
+		FillSlots(2 * k + 1, next);
+	}
+
+	//! Position of the range containing value, or 0 if there is none
+	int64_t Probe(BOUND_TYPE value) const {
+		// Descend right while the slot's range starts at or before value. The path taken ends in the bits of k:
+		// dropping its trailing right turns and the last left turn leaves the first slot starting after value,
+		// or 0 if every range starts at or before it.
+		idx_t k = 1;
+		while (k < lowers.size()) {
+			k = 2 * k + ((lowers[k] < value) | ((lowers[k] == value) & lower_inc[k]));
+		}
+		while (k & 1) {
+			k >>= 1;
+		}
+		k >>= 1;
+		auto after = k == 0 ? ranges.size() : order[k];
+		if (after == 0 || !ContainsValue(ranges[after - 1], value)) {
+			return 0;
+		}
+		return positions[after - 1];
+	}
+};
+
+//! Bind data of the functions probing a constant list of ranges through INDEX
+template <class INDEX>
+struct RangeListBindData : public FunctionData {
+	RangeListBindData(Value ranges_p, shared_ptr<const INDEX> index_p)
+	    : ranges(std::move(ranges_p)), index(std::move(index_p)) {
+	}
+
+	Value ranges;
+	shared_ptr<const INDEX> index;
+
+	unique_ptr<FunctionData> Copy() const override {
+		return make_uniq<RangeListBindData<INDEX>>(ranges, index);
+	}
+	bool Equals(const FunctionData &other_p) const override {
+		auto &other = other_p.Cast<RangeListBindData<INDEX>>();
+		return Value::NotDistinctFrom(ranges, other.ranges);
+	}
+};
+
+// Applications probing the same list many times (a pricing grid in a variable, a prepared statement executed per
+// request) would otherwise pay for sorting it on every bind. The indexes of the most recently used lists are kept
+// for the whole process, keyed by the list contents, so a changed list is simply a miss and evicts nothing that is
+// still in use: the bind data shares ownership of its index. Entries are told apart by a fingerprint of a bounded
+// sample of the list, but a hit still costs what the bind cannot avoid: materializing the constant list and one
+// comparison pass to confirm it is the cached one. Only the sort and the index build are saved.
+static constexpr idx_t RANGE_LIST_INDEX_CACHE_SIZE = 8;
+static constexpr idx_t RANGE_LIST_FINGERPRINT_SAMPLES = 64;
+
+//! Hashes the length of a list and up to RANGE_LIST_FINGERPRINT_SAMPLES evenly spaced elements, so the cost of
+//! telling lists apart does not grow with their length
+static hash_t RangeListFingerprint(const Value &ranges) {
+	auto &elements = ListValue::GetChildren(ranges);
+	auto hash = Hash(uint64_t(elements.size()));
+	auto step = MaxValue<idx_t>(elements.size() / RANGE_LIST_FINGERPRINT_SAMPLES, 1);
+	for (idx_t i = 0; i < elements.size(); i += step) {
+		hash = CombineHash(hash, elements[i].Hash());
+	}
+	return hash;
+}
+
+//! Process-wide cache of the INDEX built for recently bound lists, most recently used last
+template <class INDEX>
+struct RangeListIndexCache {
+	struct Entry {
+		hash_t hash;
+		Value ranges;
+		shared_ptr<const INDEX> index;
+	};
+
+	//! Returns the cached index of ranges, or builds and caches it; hit tells which of the two happened
+	static shared_ptr<const INDEX> GetOrBuild(const Value &ranges, bool &hit) {
+		auto hash = RangeListFingerprint(ranges);
+		auto &cache = Get();
+		{
+			lock_guard<mutex> guard(cache.lock);
+			for (auto it = cache.entries.begin(); it != cache.entries.end(); ++it) {
+				if (it->hash == hash && Value::NotDistinctFrom(it->ranges, ranges)) {
+					std::rotate(it, it + 1, cache.entries.end());
+					hit = true;
+					return cache.entries.back().index;
+				}
+			}
+		}
+		// Build outside the lock, a list that fails to build (e.g. overlapping buckets) is not cached
+		hit = false;
+		auto index = make_shared_ptr<INDEX>();
+		index->Build(ranges);
+		lock_guard<mutex> guard(cache.lock);
+		if (cache.entries.size() >= RANGE_LIST_INDEX_CACHE_SIZE) {
+			cache.entries.erase(cache.entries.begin());
+		}
+		cache.entries.push_back(Entry {hash, ranges, index});
+		return index;
+	}
+
+private:
+	mutex lock;
+	vector<Entry> entries;
+
+	static RangeListIndexCache &Get() {
+		static RangeListIndexCache cache;
+		return cache;
+	}
+};
+
+//! Evaluates the constant list of ranges in argument LIST_ARG and looks up or builds its INDEX once
+template <class INDEX, idx_t LIST_ARG>
+static unique_ptr<FunctionData> BindRangeList(ClientContext &context, ScalarFunction &bound_function,
+                                              vector<unique_ptr<Expression>> &arguments) {
+	auto &ranges = *arguments[LIST_ARG];
+	if (!ranges.IsFoldable()) {
+		throw BinderException("%s: the list of ranges must be a constant, e.g. a literal or getvariable()",
+		                      bound_function.name);
+	}
+	auto value = ExpressionExecutor::EvaluateScalar(context, ranges);
+	shared_ptr<const INDEX> index;
+	if (value.IsNull()) {
+		index = make_shared_ptr<INDEX>();
+	} else {
+		bool hit;
+		index = RangeListIndexCache<INDEX>::GetOrBuild(value, hit);
+		if (RangeStatsState::IsEnabled(context)) {
+			auto &site = RangeStatsState::Get(context)->Site(RangeStatsSiteName(bound_function) + " index cache");
+			site.Add(hit ? RangeStatsCounter::CACHE_HITS : RangeStatsCounter::CACHE_MISSES, 1);
+		}
+	}
+	return make_uniq<RangeListBindData<INDEX>>(std::move(value), std::move(index));
+}
+
+template <class RANGE>
+static void RangeLookupFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	using BOUND_TYPE = decltype(RANGE::lower);
+	auto &bind_data =
+	    state.expr.Cast<BoundFunctionExpression>().bind_info->Cast<RangeListBindData<RangeLookupIndex<RANGE>>>();
+	auto &value_vec = args.data[1];
+	auto count = args.size();
+	if (bind_data.ranges.IsNull()) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+		ConstantVector::SetNull(result, true);
+		return;
+	}
+	ValueReader<BOUND_TYPE> values(value_vec, count);
+	auto is_constant = value_vec.GetVectorType() == VectorType::CONSTANT_VECTOR;
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto list_entries = FlatVector::GetData<list_entry_t>(result);
+	vector<int64_t> matches;
+	auto row_count = is_constant ? 1 : count;
+	for (idx_t i = 0; i < row_count; i++) {
+		if (!values.RowIsValid(i)) {
+			FlatVector::SetNull(result, i, true);
+			continue;
+		}
+		bind_data.index->Probe(values.Get(i), matches);
+		auto offset = ListVector::GetListSize(result);
+		ListVector::Reserve(result, offset + matches.size());
+		auto match_data = FlatVector::GetData<int64_t>(ListVector::GetEntry(result));
+		for (idx_t m = 0; m < matches.size(); m++) {
+			match_data[offset + m] = matches[m];
+		}
+		ListVector::SetListSize(result, offset + matches.size());
+		list_entries[i] = list_entry_t(offset, matches.size());
+	}
+	if (is_constant) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	}
+}
+
+template <class RANGE>
+static void RangeBucketFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	using BOUND_TYPE = decltype(RANGE::lower);
+	auto &bind_data =
+	    state.expr.Cast<BoundFunctionExpression>().bind_info->Cast<RangeListBindData<RangeBucketIndex<RANGE>>>();
+	auto &value_vec = args.data[0];
+	auto count = args.size();
+	if (bind_data.ranges.IsNull()) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+		ConstantVector::SetNull(result, true);
+		return;
+	}
+	ValueReader<BOUND_TYPE> values(value_vec, count);
+	auto is_constant = value_vec.GetVectorType() == VectorType::CONSTANT_VECTOR;
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<int64_t>(result);
+	auto &index = *bind_data.index;
+	auto row_count = is_constant ? 1 : count;
+	for (idx_t i = 0; i < row_count; i++) {
+		if (!values.RowIsValid(i)) {
+			FlatVector::SetNull(result, i, true);
+			continue;
+		}
+		result_data[i] = index.Probe(values.Get(i));
+		if (result_data[i] == 0) {
+			FlatVector::SetNull(result, i, true);
+		}
+	}
+	if (is_constant) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	}
+}
+
+template <class RANGE>
+static void RegisterRangeLookup(ExtensionLoader &loader) {
+	using BOUND_TYPE = decltype(RANGE::lower);
+	auto range_type = GetRangeType<BOUND_TYPE>();
+	ScalarFunction lookup_fun("range_lookup", {LogicalType::LIST(range_type), RangeTraits<BOUND_TYPE>::BoundType()},
+	                          LogicalType::LIST(LogicalType::BIGINT), RangeLookupFunction<RANGE>,
+	                          BindRangeList<RangeLookupIndex<RANGE>, 0>);
+	RegisterRangeFunction(loader, lookup_fun);
+
+	ScalarFunction bucket_fun("range_bucket", {RangeTraits<BOUND_TYPE>::BoundType(), LogicalType::LIST(range_type)},
+	                          LogicalType::BIGINT, RangeBucketFunction<RANGE>,
+	                          BindRangeList<RangeBucketIndex<RANGE>, 1>);
+	RegisterRangeFunction(loader, bucket_fun);
+}
+
+//===--------------------------------------------------------------------===//
+// Range Unnest
+//===--------------------------------------------------------------------===//
+// range_unnest(range) -> TABLE(range_unnest): one row per member of a discrete range (INT4RANGE, INT8RANGE or
+// DATERANGE), e.g. `FROM bookings, range_unnest(bookings.stay)` to expand stays into days. It is a table in-out
+// function, so members are written straight from the decoded ranges into vector-sized output chunks. A range
+// with more members than fit into one chunk is resumed on the next call instead of being materialized, so the
+// expansion streams in constant memory however large the ranges are.
+
+struct RangeUnnestBindData : public TableFunctionData {
+	explicit RangeUnnestBindData(LogicalType bound_type_p) : bound_type(std::move(bound_type_p)) {
+	}
+
+	LogicalType bound_type;
+};
+
+//! Position of the expansion within the current input chunk
+template <class RANGE>
+struct RangeUnnestState : public LocalTableFunctionState {
+	using BOUND_TYPE = decltype(RANGE::lower);
+
+	RangeUnnestState() : row(0), in_row(false) {
+	}
+
+	//! Row of the input chunk being expanded
+	idx_t row;
+	//! Whether the members of that row have been partially written, up to (excluding) next
+	bool in_row;
+	BOUND_TYPE next;
+	BOUND_TYPE upper;
+	bool upper_inc;
+};
+
+template <class RANGE>
+static OperatorResultType RangeUnnestRows(RangeUnnestState<RANGE> &state, DataChunk &input, DataChunk &output) {
+	using BOUND_TYPE = decltype(RANGE::lower);
+	using TRAITS = RangeTraits<BOUND_TYPE>;
+	RangeReader<RANGE> ranges(input.data[0], input.size());
+	auto result_data = FlatVector::GetData<BOUND_TYPE>(output.data[0]);
+	idx_t count = 0;
+	while (state.row < input.size() && count < STANDARD_VECTOR_SIZE) {
+		if (!state.in_row) {
+			if (!ranges.RowIsValid(state.row)) {
+				state.row++;
+				continue;
+			}
+			auto range = ranges.Get(state.row);
+			if (IsEmpty(range)) {
+				state.row++;
+				continue;
+			}
+			if (range.lower_inf || range.upper_inf) {
+				throw InvalidInputException("range_unnest: cannot expand a range with an infinite bound");
+			}
+			state.next = range.lower;
+			state.upper = range.upper;
+			state.upper_inc = range.upper_inc;
+			state.in_row = true;
+		}
+		// Stored ranges are [lower, upper), except for one ending at the highest value, whose successor does
+		// not exist
+		while (count < STANDARD_VECTOR_SIZE) {
+			auto value = state.next;
+			result_data[count++] = value;
+			if (state.upper_inc ? value == state.upper : TRAITS::Successor(value) == state.upper) {
+				state.in_row = false;
+				state.row++;
+				break;
+			}
+			state.next = TRAITS::Successor(value);
+		}
+	}
+	output.SetCardinality(count);
+	if (state.row < input.size()) {
+		return OperatorResultType::HAVE_MORE_OUTPUT;
+	}
+	state.row = 0;
+	return OperatorResultType::NEED_MORE_INPUT;
+}
+
+static unique_ptr<FunctionData> BindRangeUnnest(ClientContext &context, TableFunctionBindInput &input,
+                                                vector<LogicalType> &return_types, vector<string> &names) {
+	if (input.input_table_types.size() != 1 || (input.input_table_types[0] != GetRangeType<int32_t>() &&
+	                                             input.input_table_types[0] != GetRangeType<int64_t>() &&
+	                                             input.input_table_types[0] != GetRangeType<date_t>())) {
+		throw BinderException("range_unnest: expected a single INT4RANGE, INT8RANGE or DATERANGE argument");
+	}
+	auto bound_type = StructType::GetChildType(input.input_table_types[0], RANGE_LOWER_INDEX);
+	return_types.push_back(bound_type);
+	names.push_back("range_unnest");
+	return make_uniq<RangeUnnestBindData>(bound_type);
+}
+
+static unique_ptr<LocalTableFunctionState> RangeUnnestInitLocal(ExecutionContext &context,
+                                                                TableFunctionInitInput &input,
+                                                                GlobalTableFunctionState *global_state) {
+	auto &bind_data = input.bind_data->Cast<RangeUnnestBindData>();
+	switch (bind_data.bound_type.id()) {
+	case LogicalTypeId::INTEGER:
+		return make_uniq<RangeUnnestState<Int4Range>>();
+	case LogicalTypeId::BIGINT:
+		return make_uniq<RangeUnnestState<Int8Range>>();
+	case LogicalTypeId::DATE:
+		return make_uniq<RangeUnnestState<DateRange>>();
+	default:
+		throw InternalException("range_unnest: unsupported bound type");
+	}
+}
+
+static OperatorResultType RangeUnnestFunction(ExecutionContext &context, TableFunctionInput &data, DataChunk &input,
+                                              DataChunk &output) {
+	auto &bind_data = data.bind_data->Cast<RangeUnnestBindData>();
+	switch (bind_data.bound_type.id()) {
+	case LogicalTypeId::INTEGER:
+		return RangeUnnestRows(data.local_state->Cast<RangeUnnestState<Int4Range>>(), input, output);
+	case LogicalTypeId::BIGINT:
+		return RangeUnnestRows(data.local_state->Cast<RangeUnnestState<Int8Range>>(), input, output);
+	case LogicalTypeId::DATE:
+		return RangeUnnestRows(data.local_state->Cast<RangeUnnestState<DateRange>>(), input, output);
+	default:
+		throw InternalException("range_unnest: unsupported bound type");
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// Optimizer: Implied Bound Predicates
+//===--------------------------------------------------------------------===//
+// A containment predicate like `v <@ r` is opaque to DuckDB, so a join on it runs as a nested loop and
+// calls RangeContainedBy for every pair. Containment implies `r.lower <= v AND v <= r.upper` (and
+// range_overlaps(a, b) implies `a.lower <= b.upper AND b.lower <= a.upper`), so before the built-in
+// optimizers run we add those comparisons next to the original predicate. Filter pushdown
+// then turns them into regular inequality join conditions (planned as an IEJoin / piecewise merge join),
+// while the original predicate stays in place to apply the exact inclusivity semantics.
+//
+// Against a constant, the same comparisons become table filters on the bound children of a range column, so a
+// point lookup like `band @> 105` or `band @> '[10,20)'` skips every row group whose zonemaps rule it out. A
+// table stored in range order (e.g. created with ORDER BY band) is thereby probed like a clustered index.
+
+static bool IsRangeType(const LogicalType &type) {
+	return type == GetRangeType<int32_t>() || type == GetRangeType<int64_t>() || type == GetRangeType<double>() ||
+	       type == GetRangeType<date_t>() || type == GetRangeType<timestamp_t>() ||
+	       type == GetRangeType<timestamp_tz_t>();
+}
+
+static unique_ptr<Expression> ExtractRangeBound(ClientContext &context, const Expression &range, const char *field) {
+	vector<unique_ptr<Expression>> children;
+	children.push_back(range.Copy());
+	children.push_back(make_uniq<BoundConstantExpression>(Value(field)));
+	ErrorData error;
+	FunctionBinder binder(context);
+	auto result = binder.BindScalarFunction(DEFAULT_SCHEMA, "struct_extract", std::move(children), error);
+	if (!result) {
+		error.Throw();
+	}
+	return result;
+}
+
+static unique_ptr<Expression> MakeLessThanEquals(unique_ptr<Expression> left, unique_ptr<Expression> right) {
+	return make_uniq<BoundComparisonExpression>(ExpressionType::COMPARE_LESSTHANOREQUALTO, std::move(left),
+	                                            std::move(right));
+}
+
+static void AddContainmentBounds(ClientContext &context, const Expression &range, const Expression &value,
+                                 vector<unique_ptr<Expression>> &implied) {
+	if (range.IsFoldable() && value.IsFoldable()) {
+		// constant folding already takes care of this
+		return;
+	}
+	implied.push_back(MakeLessThanEquals(ExtractRangeBound(context, range, "lower"), value.Copy()));
+	implied.push_back(MakeLessThanEquals(value.Copy(), ExtractRangeBound(context, range, "upper")));
+}
+
+// outer @> inner for a constant inner range: outer starts no later and ends no earlier than inner. The empty
+// range is contained in every range, so an empty constant implies nothing.
+static void AddRangeContainmentBounds(ClientContext &context, const Expression &outer, const Expression &inner,
+                                      vector<unique_ptr<Expression>> &implied) {
+	if (outer.IsFoldable() || !inner.IsFoldable()) {
+		return;
+	}
+	Value inner_value;
+	if (!ExpressionExecutor::TryEvaluateScalar(context, inner, inner_value) || inner_value.IsNull()) {
+		return;
+	}
+	auto &children = StructValue::GetChildren(inner_value);
+	if (children[RANGE_LOWER_KIND_INDEX].IsNull() || children[RANGE_UPPER_KIND_INDEX].IsNull() ||
+	    (children[RANGE_LOWER_KIND_INDEX].GetValue<uint8_t>() == RANGE_EMPTY_KIND &&
+	     children[RANGE_UPPER_KIND_INDEX].GetValue<uint8_t>() == RANGE_EMPTY_KIND)) {
+		return;
+	}
+	implied.push_back(MakeLessThanEquals(ExtractRangeBound(context, outer, "lower"),
+	                                     make_uniq<BoundConstantExpression>(children[RANGE_LOWER_INDEX])));
+	implied.push_back(MakeLessThanEquals(make_uniq<BoundConstantExpression>(children[RANGE_UPPER_INDEX]),
+	                                     ExtractRangeBound(context, outer, "upper")));
+}
+
+static void AddOverlapBounds(ClientContext &context, const Expression &r1, const Expression &r2,
+                             vector<unique_ptr<Expression>> &implied) {
+	if (r1.IsFoldable() && r2.IsFoldable()) {
+		return;
+	}
+	// Two ranges can only share a point if each one starts before the other ends
+	implied.push_back(
+	    MakeLessThanEquals(ExtractRangeBound(context, r1, "lower"), ExtractRangeBound(context, r2, "upper")));
+	implied.push_back(
+	    MakeLessThanEquals(ExtractRangeBound(context, r2, "lower"), ExtractRangeBound(context, r1, "upper")));
+}
+
+// Returns the range argument of lower(range) / upper(range) and the name of the bound, or nullptr
+static const Expression *MatchBoundAccessor(const Expression &expr, const char *&field) {
+	if (expr.GetExpressionClass() != ExpressionClass::BOUND_FUNCTION) {
+		return nullptr;
+	}
+	auto &func = expr.Cast<BoundFunctionExpression>();
+	if (func.children.size() != 1 || !IsRangeType(func.children[0]->return_type)) {
+		return nullptr;
+	}
+	if (func.function.name == "lower") {
+		field = "lower";
+	} else if (func.function.name == "upper") {
+		field = "upper";
+	} else {
+		return nullptr;
+	}
+	return func.children[0].get();
+}
+
+// lower(r) > x implies the same comparison on the stored bound, which equals lower(r) whenever that is not NULL.
+// Unlike the function call, the comparison on the bound child is pushed into the scan and checked against its
+// zonemaps.
+static void AddAccessorBounds(ClientContext &context, const BoundComparisonExpression &comparison,
+                              vector<unique_ptr<Expression>> &implied) {
+	switch (comparison.GetExpressionType()) {
+	case ExpressionType::COMPARE_EQUAL:
+	case ExpressionType::COMPARE_LESSTHAN:
+	case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+	case ExpressionType::COMPARE_GREATERTHAN:
+	case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+		break;
+	default:
+		return;
+	}
+	if (comparison.IsVolatile()) {
+		return;
+	}
+	const char *left_field = nullptr;
+	const char *right_field = nullptr;
+	auto left_range = MatchBoundAccessor(*comparison.left, left_field);
+	auto right_range = MatchBoundAccessor(*comparison.right, right_field);
+	if (!left_range && !right_range) {
+		return;
+	}
+	auto left = left_range ? ExtractRangeBound(context, *left_range, left_field) : comparison.left->Copy();
+	auto right = right_range ? ExtractRangeBound(context, *right_range, right_field) : comparison.right->Copy();
+	implied.push_back(
+	    make_uniq<BoundComparisonExpression>(comparison.GetExpressionType(), std::move(left), std::move(right)));
+}
+
+// Splits a containment predicate into its (range, value) operands, or returns false
+static bool MatchContainment(const Expression &expr, const Expression *&range, const Expression *&value) {
+	if (expr.GetExpressionClass() != ExpressionClass::BOUND_FUNCTION || expr.IsVolatile()) {
+		return false;
+	}
+	auto &func = expr.Cast<BoundFunctionExpression>();
+	if (func.children.size() != 2) {
+		return false;
+	}
+	auto &name = func.function.name;
+	auto &left = *func.children[0];
+	auto &right = *func.children[1];
+	if ((name == "@>" || name == "range_contains") && IsRangeType(left.return_type) &&
+	    !IsRangeType(right.return_type)) {
+		range = &left;
+		value = &right;
+		return true;
+	}
+	if (name == "<@" && !IsRangeType(left.return_type) && IsRangeType(right.return_type)) {
+		range = &right;
+		value = &left;
+		return true;
+	}
+	return false;
+}
+
+static void CollectImpliedPredicates(ClientContext &context, const Expression &expr,
+                                     vector<unique_ptr<Expression>> &implied) {
+	if (expr.GetExpressionType() == ExpressionType::CONJUNCTION_AND) {
+		for (auto &child : expr.Cast<BoundConjunctionExpression>().children) {
+			CollectImpliedPredicates(context, *child, implied);
+		}
+		return;
+	}
+	if (expr.GetExpressionClass() == ExpressionClass::BOUND_COMPARISON) {
+		AddAccessorBounds(context, expr.Cast<BoundComparisonExpression>(), implied);
+		return;
+	}
+	const Expression *range = nullptr;
+	const Expression *value = nullptr;
+	if (MatchContainment(expr, range, value)) {
+		AddContainmentBounds(context, *range, *value, implied);
+		return;
+	}
+	if (expr.GetExpressionClass() != ExpressionClass::BOUND_FUNCTION || expr.IsVolatile()) {
+		return;
+	}
+	auto &func = expr.Cast<BoundFunctionExpression>();
+	if (func.children.size() != 2) {
+		return;
+	}
+	auto &left = *func.children[0];
+	auto &right = *func.children[1];
+	if (!IsRangeType(left.return_type) || left.return_type != right.return_type) {
+		return;
+	}
+	auto &name = func.function.name;
+	if (name == "range_overlaps" || name == "&&") {
+		AddOverlapBounds(context, left, right, implied);
+	} else if (name == "@>") {
+		AddRangeContainmentBounds(context, left, right, implied);
+	} else if (name == "<@") {
+		AddRangeContainmentBounds(context, right, left, implied);
+	}
+}
+
+static unique_ptr<Expression> MakeBoundComparison(ExpressionType type, const Expression &value, const Value &bound) {
+	return make_uniq<BoundComparisonExpression>(type, value.Copy(), make_uniq<BoundConstantExpression>(bound));
+}
+
+// Replaces `v <@ <constant range>` in a filter with the exact comparisons it stands for, e.g.
+// `v >= 100 AND v < 200` for '[100,200)'. Unlike the function call these are understood by filter pushdown, so
+// they become table filters that skip row groups through zonemaps (and Parquet statistics) and never call back
+// into the extension. Both forms are NULL for a NULL value, which a filter treats the same as false.
+static bool RewriteConstantContainment(ClientContext &context, unique_ptr<Expression> &expr,
+                                       vector<unique_ptr<Expression>> &rewritten) {
+	const Expression *range = nullptr;
+	const Expression *value = nullptr;
+	if (!MatchContainment(*expr, range, value) || !range->IsFoldable() || value->IsFoldable()) {
+		return false;
+	}
+	Value range_value;
+	if (!ExpressionExecutor::TryEvaluateScalar(context, *range, range_value) || range_value.IsNull()) {
+		return false;
+	}
+	auto &children = StructValue::GetChildren(range_value);
+	for (auto &child : children) {
+		if (child.IsNull()) {
+			return false;
+		}
+	}
+	auto &lower_bound = children[RANGE_LOWER_INDEX];
+	auto &upper_bound = children[RANGE_UPPER_INDEX];
+	auto lower_kind = children[RANGE_LOWER_KIND_INDEX].GetValue<uint8_t>();
+	auto upper_kind = children[RANGE_UPPER_KIND_INDEX].GetValue<uint8_t>();
+	if (lower_kind == RANGE_EMPTY_KIND && upper_kind == RANGE_EMPTY_KIND) {
+		// Nothing is contained in an empty range; the filter optimizer prunes the whole scan
+		expr = make_uniq<BoundConstantExpression>(Value::BOOLEAN(false));
+		return true;
+	}
+	// An infinite side needs no comparison at all, so only the finite bound ends up as a table filter; a range
+	// that is unbounded on both sides keeps the function call
+	bool lower_inf = lower_kind == RANGE_LOWER_INFINITE;
+	bool upper_inf = upper_kind == RANGE_UPPER_INFINITE;
+	if (lower_inf && upper_inf) {
+		return false;
+	}
+	bool lower_inc = lower_kind == RANGE_LOWER_INCLUSIVE;
+	bool upper_inc = upper_kind == RANGE_UPPER_INCLUSIVE;
+	auto lower_cmp = lower_inc ? ExpressionType::COMPARE_GREATERTHANOREQUALTO : ExpressionType::COMPARE_GREATERTHAN;
+	auto upper_cmp = upper_inc ? ExpressionType::COMPARE_LESSTHANOREQUALTO : ExpressionType::COMPARE_LESSTHAN;
+	if (lower_inf) {
+		expr = MakeBoundComparison(upper_cmp, *value, upper_bound);
+		return true;
+	}
+	auto lower = MakeBoundComparison(lower_cmp, *value, lower_bound);
+	if (!upper_inf) {
+		rewritten.push_back(MakeBoundComparison(upper_cmp, *value, upper_bound));
+	} else if (range->return_type == GetRangeType<double>()) {
+		// DuckDB orders NaN above every double, but no range contains it: compare against the stored upper bound
+		// (infinity) to keep NaN out
+		rewritten.push_back(MakeBoundComparison(ExpressionType::COMPARE_LESSTHANOREQUALTO, *value, upper_bound));
+	}
+	expr = std::move(lower);
+	return true;
+}
+
+static void AddImpliedRangePredicates(ClientContext &context, unique_ptr<LogicalOperator> &op) {
+	for (auto &child : op->children) {
+		AddImpliedRangePredicates(context, child);
+	}
+	vector<unique_ptr<Expression>> implied;
+	if (op->type == LogicalOperatorType::LOGICAL_FILTER) {
+		auto &filter = op->Cast<LogicalFilter>();
+		LogicalFilter::SplitPredicates(filter.expressions);
+		for (auto &expr : filter.expressions) {
+			if (!RewriteConstantContainment(context, expr, implied)) {
+				CollectImpliedPredicates(context, *expr, implied);
+			}
+		}
+		for (auto &expr : implied) {
+			filter.expressions.push_back(std::move(expr));
+		}
+	} else if (op->type == LogicalOperatorType::LOGICAL_ANY_JOIN) {
+		// Only inner joins are turned into filters over a cross product by filter pushdown
+		auto &join = op->Cast<LogicalAnyJoin>();
+		if (join.join_type != JoinType::INNER) {
+			return;
+		}
+		CollectImpliedPredicates(context, *join.condition, implied);
+		for (auto &expr : implied) {
+			join.condition = make_uniq<BoundConjunctionExpression>(ExpressionType::CONJUNCTION_AND,
+			                                                       std::move(join.condition), std::move(expr));
+		}
+	}
+}
+
+static void RangesPreOptimize(OptimizerExtensionInput &input, unique_ptr<LogicalOperator> &plan) {
+	AddImpliedRangePredicates(input.context, plan);
+}
+
+//! Registers everything for one range subtype: the range type and its functions, its operators, its
+//! aggregates, its multirange type and range_lookup
+template <class RANGE>
+static void RegisterRangeSubtype(ExtensionLoader &loader, AggregateFunctionSet &range_agg_set,
+                                 AggregateFunctionSet &range_merge_set) {
+	RegisterRangeType<RANGE>(loader);
+	RegisterRangeOperators<RANGE>(loader);
+	AddRangeAggregates<RANGE>(range_agg_set, range_merge_set);
+	RegisterMultirangeType<RANGE>(loader);
+	RegisterRangeLookup<RANGE>(loader);
+}
+
+static void LoadInternal(ExtensionLoader &loader) {
+	// Range types, each with its operators, aggregates (range_agg, range_merge) and multirange type
+	AggregateFunctionSet range_agg_set("range_agg");
+	AggregateFunctionSet range_merge_set("range_merge");
+	RegisterRangeSubtype<Int4Range>(loader, range_agg_set, range_merge_set);
+	RegisterRangeSubtype<Int8Range>(loader, range_agg_set, range_merge_set);
+	RegisterRangeSubtype<NumRange>(loader, range_agg_set, range_merge_set);
+	RegisterRangeSubtype<DateRange>(loader, range_agg_set, range_merge_set);
+	RegisterRangeSubtype<TsRange>(loader, range_agg_set, range_merge_set);
+	RegisterRangeSubtype<TstzRange>(loader, range_agg_set, range_merge_set);
+	loader.RegisterFunction(range_agg_set);
+	loader.RegisterFunction(range_merge_set);
+	auto range_coalesce = DefaultTableFunctionGenerator::CreateTableMacroInfo(RANGE_COALESCE_MACRO);
+	loader.RegisterFunction(*range_coalesce);
+
+	// Counters: SET ranges_stats = true, then FROM ranges_stats()
+	auto &config = DBConfig::GetConfig(loader.GetDatabaseInstance());
+	config.AddExtensionOption("ranges_stats", "Count the chunks and rows processed by range functions and casts",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false), SetRangeStats);
+	TableFunction ranges_stats("ranges_stats", {}, RangeStatsFunction, BindRangeStats, InitRangeStats);
+	loader.RegisterFunction(ranges_stats);
+
+	// Table function: range_unnest(range) over the discrete range types
+	TableFunction range_unnest("range_unnest", {LogicalType::TABLE}, nullptr, BindRangeUnnest, nullptr,
+	                           RangeUnnestInitLocal);
+	range_unnest.in_out_function = RangeUnnestFunction;
+	loader.RegisterFunction(range_unnest);
+
+	// Cast: BLOB -> INT4RANGE / NUMRANGE (explicit only, migrates the legacy 9-byte and 17-byte encodings)
+	loader.RegisterCastFunction(LogicalType::BLOB, GetInt4RangeType(),
+	                            RangeCastInfo(BlobToRangeCast<Int4Range>, "BLOB -> INT4RANGE"));
+	loader.RegisterCastFunction(LogicalType::BLOB, GetNumRangeType(),
+	                            RangeCastInfo(BlobToRangeCast<NumRange>, "BLOB -> NUMRANGE"));
+
+	// Optimizer: derive bound comparisons from range predicates so joins and scans can use them
+	OptimizerExtension range_optimizer;
+	range_optimizer.pre_optimize_function = RangesPreOptimize;
+	config.optimizer_extensions.push_back(std::move(range_optimizer));
 }
 
 void RangesExtension::Load(ExtensionLoader &loader) {